@@ -9,6 +9,9 @@
 #include <Book/Animation.hpp>
 #include <SFML/Graphics/Sprite.hpp>
 
+class BulletSystem;
+class RandomGenerator;
+
 class Aircraft : public Entity
 {
 	public:
@@ -20,11 +23,15 @@ class Aircraft : public Entity
 			TypeCount
 		};
 	public:
-								Aircraft(Type type, const TextureHolder& textures, const FontHolder& fonts);
+								Aircraft(Type type, const TextureHolder& textures, const FontHolder& fonts, EntityStore& entities,
+									const ParticleRegistry& particles, RandomGenerator& random);
 		virtual unsigned int	getCategory() const;
 		virtual sf::FloatRect	getBoundingRect() const;
+		virtual sf::FloatRect	getHitBox() const;
+		virtual sf::IntRect		getTextureRect() const;
 		virtual void			remove();
 		virtual bool 			isMarkedForRemoval() const;
+		virtual void			steer(sf::Time dt);
 		bool					isAllied() const;
 		float					getMaxSpeed() const;
 		void					increaseFireRate();
@@ -35,12 +42,15 @@ class Aircraft : public Entity
 		void					playLocalSound(CommandQueue& commands, SoundEffect::ID effect);
 	private:
 		virtual void			drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
+		virtual void			snapshotCurrent(RenderSnapshot& snapshot, sf::RenderStates states) const;
 		virtual void 			updateCurrent(sf::Time dt, CommandQueue& commands);
 		void					updateMovementPattern(sf::Time dt);
 		void					checkPickupDrop(CommandQueue& commands);
 		void					checkProjectileLaunch(sf::Time dt, CommandQueue& commands);
-		void					createBullets(SceneNode& node, const TextureHolder& textures) const;
-		void					createProjectile(SceneNode& node, Projectile::Type type, float xOffset, float yOffset, const TextureHolder& textures) const;
+		void					createBullets(BulletSystem& bullets) const;
+		void					createBullet(BulletSystem& bullets, Projectile::Type type, float xOffset, float yOffset) const;
+		void					createProjectile(SceneNode& node, Projectile::Type type, float xOffset, float yOffset, const TextureHolder& textures,
+									const ParticleRegistry& particles) const;
 		void					createPickup(SceneNode& node, const TextureHolder& textures) const;
 		void					updateTexts();
 		void					updateRollAnimation();
@@ -64,6 +74,7 @@ class Aircraft : public Entity
 		std::size_t				mDirectionIndex;
 		TextNode*				mHealthDisplay;
 		TextNode*				mMissileDisplay;
+		RandomGenerator&		mRandom;
 };
 
 #endif // BOOK_AIRCRAFT_HPP
@@ -7,33 +7,71 @@
 #include <Book/StateStack.hpp>
 #include <Book/MusicPlayer.hpp>
 #include <Book/SoundPlayer.hpp>
+#include <Book/JobSystem.hpp>
+#include <Book/GraphicsSettings.hpp>
+#include <Book/RenderTargetPool.hpp>
+#include <Book/RenderThread.hpp>
+#include <Book/FrameBudgetMonitor.hpp>
+#include <Book/FrameLimiter.hpp>
+#include <Book/ResolutionScaler.hpp>
+#include <Book/CollisionStatistics.hpp>
 #include <SFML/System/Time.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/Text.hpp>
+#include <array>
+#include <memory>
 
 class Application
 {
 	public:
-								Application();
+		explicit				Application(sf::Uint64 seed = 0, std::size_t maxUpdatesPerFrame = 0);
 		void					run();
 	private:
 		void					processInput();
 		void					update(sf::Time dt);
-		void					render();
+		void					render(float interpolation);
+		void					closeWindow();
+		void					updateRenderThread();
+		void					updateFramePacing();
 		void					updateStatistics(sf::Time dt);
+		void					updateResolutionScale();
 		void					registerStates();
+	private:
+		// 一种泛光实现在若干帧内的泛光各遍与整个渲染阶段的耗时
+		struct BloomTiming
+		{
+			sf::Time				bloomTime;
+			sf::Time				renderTime;
+			std::size_t				frames;
+		};
 	private:
 		static const sf::Time	TimePerFrame;
+		static const float		RenderBudgetRatio;
+		static const bool		IdleModeEnabled;
 		sf::RenderWindow		mWindow;
 		TextureHolder			mTextures;
 	  	FontHolder				mFonts;
 		Player					mPlayer;
 		MusicPlayer				mMusic;
 		SoundPlayer				mSounds;
+		JobSystem				mJobs;
+		GraphicsSettings		mGraphics;
+		RenderTargetPool		mRenderTargets;
+		CollisionStatistics		mCollisionStatistics;
 		StateStack				mStateStack;
 		sf::Text				mStatisticsText;
 		sf::Time				mStatisticsUpdateTime;
 		std::size_t				mStatisticsNumFrames;
+		std::array<BloomTiming, 2>	mBloomTimings;
+		std::array<BloomTiming, 2>	mBloomAverages;
+		std::size_t				mLastTimedFrame;
+		std::unique_ptr<RenderThread>	mRenderThread;
+		FrameBudgetMonitor		mFrameMonitor;
+		FrameLimiter			mFrameLimiter;
+		unsigned int			mFramerateLimit;
+		bool					mVerticalSync;
+		ResolutionScaler		mResolutionScaler;
+		std::size_t				mLastScaledFrame;
 };
 
 #endif // BOOK_APPLICATION_HPP
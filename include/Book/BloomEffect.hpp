@@ -4,29 +4,95 @@
 #include <Book/PostEffect.hpp>
 #include <Book/ResourceIdentifiers.hpp>
 #include <Book/ResourceHolder.hpp>
+#include <Book/RenderTargetPool.hpp>
 #include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/Shader.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
 #include <array>
 
 class BloomEffect : public PostEffect
 {
 	public:
-							BloomEffect();
+		enum Quality
+		{
+			Off,
+			Low,
+			Medium,
+			High,
+			QualityCount
+		};
+		enum PassType
+		{
+			CopyPass,
+			BrightnessPass,
+			BrightDownSamplePass,
+			DownSamplePass,
+			BlurPass,
+			CompositePass,
+			TemporalBlendPass,
+			PassTypeCount
+		};
+		struct Statistics
+		{
+										Statistics();
+			Quality						quality;
+			std::size_t					passCount;
+			std::array<std::size_t, PassTypeCount>	passCounts;
+			std::array<sf::Time, PassTypeCount>		passTimes;
+		};
+	public:
+		explicit			BloomEffect(RenderTargetPool& renderTargets);
+							~BloomEffect();
 		virtual void		apply(const sf::RenderTexture& input, sf::RenderTarget& output);
+		void				setQuality(Quality quality);
+		Quality				getQuality() const;
+		void				setUpdateInterval(unsigned int frames);
+		void				setHistoryWeight(float weight);
+		const Statistics&	getStatistics() const;
+		static const char*	getQualityName(Quality quality);
+		static const char*	getPassName(PassType type);
 	private:
-		typedef std::array<sf::RenderTexture, 2> RenderTextureArray;
+		typedef std::array<sf::RenderTexture*, 2> RenderTextureArray;
+		struct QualitySettings
+		{
+			bool				fusedDownSample;
+			unsigned int		firstLevelDivisor;
+			bool				secondLevel;
+			std::size_t			blurIterations;
+		};
 	private:
-		void				prepareTextures(sf::Vector2u size);
+		void				acquireTextures(sf::Vector2u size);
+		void				releaseTextures();
+		void				releaseHistory();
+		void				computeBloom(const sf::RenderTexture& input, const QualitySettings& settings);
+		void				copy(const sf::RenderTexture& input, sf::RenderTarget& output);
 		void				filterBright(const sf::RenderTexture& input, sf::RenderTexture& output);
-		void				blurMultipass(RenderTextureArray& renderTextures);
+		void				filterBrightDownSample(const sf::RenderTexture& input, sf::RenderTexture& output);
+		void				blurMultipass(RenderTextureArray& renderTextures, std::size_t iterations);
 		void				blur(const sf::RenderTexture& input, sf::RenderTexture& output, sf::Vector2f offsetFactor);
 		void				downsample(const sf::RenderTexture& input, sf::RenderTexture& output);
-		void				add(const sf::RenderTexture& source, const sf::RenderTexture& bloom, sf::RenderTarget& target);
+		void				composite(const sf::RenderTexture& source, const sf::RenderTexture& bloom,
+								const sf::RenderTexture& bloomLow, sf::RenderTarget& output, float bloomLowFactor = 1.f);
+		void				blendHistory(const sf::RenderTexture& bloom, const sf::RenderTexture& bloomLow, float bloomLowFactor,
+								const sf::RenderTexture& history, sf::RenderTexture& output, float historyWeight);
+		void				beginPass();
+		void				endPass(PassType type);
 	private:
+		static const QualitySettings	QualityTable[QualityCount];
 		ShaderHolder		mShaders;
-		sf::RenderTexture	mBrightnessTexture;
+		RenderTargetPool&	mRenderTargets;
 		RenderTextureArray	mFirstPassTextures;
 		RenderTextureArray	mSecondPassTextures;
+		Quality				mQuality;
+		unsigned int		mUpdateInterval;
+		float				mHistoryWeight;
+		RenderTextureArray	mHistoryTextures;
+		std::size_t			mHistoryIndex;
+		bool				mHistoryValid;
+		unsigned int		mFramesSinceUpdate;
+		Statistics			mStatistics;
+		sf::Clock			mPassClock;
 };
 
 #endif // BOOK_BLOOMEFFECT_HPP
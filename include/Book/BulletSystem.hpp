@@ -0,0 +1,53 @@
+#ifndef BOOK_BULLETSYSTEM_HPP
+#define BOOK_BULLETSYSTEM_HPP
+
+#include <Book/SceneNode.hpp>
+#include <Book/ResourceIdentifiers.hpp>
+#include <Book/Projectile.hpp>
+#include <Book/CollisionMask.hpp>
+#include <Book/CollisionStatistics.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <array>
+#include <vector>
+
+class JobSystem;
+class CollisionMaskAtlas;
+
+// 非制导子弹的集中存储：每个属性一个连续数组，一次遍历完成移动和剔除，绘制时合并成一个顶点数组
+// 导弹仍然使用 Projectile 节点；碰撞查询把目标按上边排序，每颗子弹只测试纵向区间重叠的目标
+class BulletSystem : public SceneNode
+{
+	public:
+								BulletSystem(const TextureHolder& textures, const CollisionMaskAtlas& masks);
+		void					addBullet(Projectile::Type type, sf::Vector2f position, sf::Vector2f direction);
+		void					updateBullets(sf::Time dt, sf::FloatRect bounds, JobSystem& jobs);
+		void					collide(Projectile::Type type, const std::vector<sf::FloatRect>& targets,
+									const std::vector<PlacedMask>& targetMasks, std::vector<int>& damages,
+									CollisionStatistics& statistics);
+		std::size_t				getBulletCount() const;
+		virtual unsigned int	getCategory() const;
+	private:
+		virtual void			drawCurrentInterpolated(sf::RenderTarget& target, sf::RenderStates states, float alpha) const;
+		virtual void			snapshotCurrentInterpolated(RenderSnapshot& snapshot, sf::RenderStates states, float alpha) const;
+		void					computeVertices(float alpha) const;
+		void					removeSpentBullets(sf::FloatRect bounds);
+	private:
+		const sf::Texture&		mTexture;
+		std::array<sf::IntRect, Projectile::TypeCount>	mTextureRects;
+		std::array<const CollisionMask*, Projectile::TypeCount>	mMasks;
+		std::vector<float>		mPositionX;
+		std::vector<float>		mPositionY;
+		std::vector<float>		mPreviousX;
+		std::vector<float>		mPreviousY;
+		std::vector<float>		mVelocityX;
+		std::vector<float>		mVelocityY;
+		std::vector<int>		mDamage;
+		std::vector<sf::Uint8>	mTypes;		// AlliedBullet 或 EnemyBullet，决定所属阵营
+		std::vector<sf::Uint8>	mSpent;		// 已经击中目标，等待剔除
+		mutable sf::VertexArray	mVertexArray;
+		std::vector<std::size_t>	mTargetOrder;
+		std::vector<float>		mTargetTops;
+};
+
+#endif // BOOK_BULLETSYSTEM_HPP
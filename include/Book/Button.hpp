@@ -39,6 +39,7 @@ class Button : public Component
         virtual void			activate();
         virtual void			deactivate();
         virtual void			handleEvent(const sf::Event& event);
+        virtual void			snapshot(RenderSnapshot& snapshot, sf::RenderStates states) const;
     private:
         virtual void			draw(sf::RenderTarget& target, sf::RenderStates states) const;
 		void					changeTexture(Type buttonType);
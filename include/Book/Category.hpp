@@ -16,6 +16,7 @@ namespace Category
 		EnemyProjectile		= 1 << 6,
 		ParticleSystem		= 1 << 7,
 		SoundEffect			= 1 << 8,
+		BulletSystem		= 1 << 9,
 		Aircraft = PlayerAircraft | AlliedAircraft | EnemyAircraft,
 		Projectile = AlliedProjectile | EnemyProjectile,
 	};
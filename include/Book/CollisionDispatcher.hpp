@@ -0,0 +1,40 @@
+#ifndef BOOK_COLLISIONDISPATCHER_HPP
+#define BOOK_COLLISIONDISPATCHER_HPP
+
+#include <Book/Category.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <array>
+#include <functional>
+#include <cassert>
+
+class SceneNode;
+
+// 按类别对登记的碰撞响应表：每个类别位对应一层，
+// 由登记的响应生成层间碰撞矩阵，宽阶段据此跳过没有响应的类别组合
+class CollisionDispatcher : private sf::NonCopyable
+{
+	public:
+		typedef std::function<void(SceneNode&, SceneNode&)> Response;
+	public:
+								CollisionDispatcher();
+		template <typename First, typename Second, typename Function>
+		void					addResponse(Category::Type first, Category::Type second, Function fn);
+		unsigned int			getCollisionMask(unsigned int category) const;
+		bool					dispatch(SceneNode& lhs, unsigned int lhsCategory, SceneNode& rhs, unsigned int rhsCategory) const;
+	private:
+		struct Entry
+		{
+			Response			response;
+			bool				swapped;
+		};
+		static const std::size_t LayerCount = 16;
+	private:
+		void					insertResponse(unsigned int first, unsigned int second, Response response);
+		static std::size_t		getLayer(unsigned int category);
+	private:
+		std::array<unsigned int, LayerCount>		mCollisionMasks;
+		std::array<Entry, LayerCount * LayerCount>	mResponses;
+};
+
+#include <Book/CollisionDispatcher.inl>
+#endif // BOOK_COLLISIONDISPATCHER_HPP
@@ -0,0 +1,11 @@
+template <typename First, typename Second, typename Function>
+void CollisionDispatcher::addResponse(Category::Type first, Category::Type second, Function fn)
+{
+	insertResponse(first, second, [=] (SceneNode& lhs, SceneNode& rhs)
+	{
+		// 检查节点是否安全
+		assert(dynamic_cast<First*>(&lhs) != nullptr);
+		assert(dynamic_cast<Second*>(&rhs) != nullptr);
+		fn(static_cast<First&>(lhs), static_cast<Second&>(rhs));
+	});
+}
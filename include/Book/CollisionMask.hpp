@@ -0,0 +1,42 @@
+#ifndef BOOK_COLLISIONMASK_HPP
+#define BOOK_COLLISIONMASK_HPP
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Config.hpp>
+#include <vector>
+
+namespace sf
+{
+	class Image;
+}
+
+// 纹理矩形的 1 位透明度遮罩，每行按 64 位字打包，行尾多出的位为 0
+// 两个遮罩按行逐字求与，只要有一位非零就说明不透明像素重叠
+class CollisionMask
+{
+	public:
+							CollisionMask();
+							CollisionMask(const sf::Image& image, const sf::IntRect& rect, bool rotated);
+		sf::Vector2i		getSize() const;
+		bool				overlaps(const CollisionMask& other, sf::Vector2i offset) const;
+	private:
+		sf::Uint64			readBits(int row, int column) const;
+	private:
+		int					mWidth;
+		int					mHeight;
+		int					mWordsPerRow;
+		std::vector<sf::Uint64>	mBits;
+};
+
+// 放到世界坐标中的遮罩，position 为遮罩左上角对应的像素；没有遮罩时 mask 为空
+struct PlacedMask
+{
+	const CollisionMask*	mask;
+	sf::Vector2i			position;
+};
+
+// 任意一方没有遮罩时无法判断，按重叠处理，保留之前碰撞框的结果
+bool				overlaps(const PlacedMask& lhs, const PlacedMask& rhs);
+
+#endif // BOOK_COLLISIONMASK_HPP
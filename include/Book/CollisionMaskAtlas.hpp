@@ -0,0 +1,30 @@
+#ifndef BOOK_COLLISIONMASKATLAS_HPP
+#define BOOK_COLLISIONMASKATLAS_HPP
+
+#include <Book/CollisionMask.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace sf
+{
+	class Texture;
+}
+
+// 载入纹理时为实体用到的每个纹理矩形生成正向和旋转 180 度的遮罩，按矩形查找
+class CollisionMaskAtlas : private sf::NonCopyable
+{
+	public:
+								CollisionMaskAtlas();
+		void					build(const sf::Texture& texture, const std::vector<sf::IntRect>& rects);
+		const CollisionMask*	find(const sf::IntRect& rect, bool rotated) const;
+		std::size_t				getMaskCount() const;
+	private:
+		typedef std::tuple<int, int, int, int, bool> Key;
+	private:
+		std::map<Key, CollisionMask>	mMasks;
+};
+
+#endif // BOOK_COLLISIONMASKATLAS_HPP
@@ -0,0 +1,20 @@
+#ifndef BOOK_COLLISIONSTATISTICS_HPP
+#define BOOK_COLLISIONSTATISTICS_HPP
+
+#include <SFML/System/Time.hpp>
+#include <cstddef>
+
+// 一步碰撞检测的计数和耗时：World 每步填写，GameState 交给 Application 显示在统计信息中
+struct CollisionStatistics
+{
+	std::size_t			tests;
+	std::size_t			candidates;
+	std::size_t			maskTests;
+	std::size_t			contacts;
+	std::size_t			bulletTests;
+	std::size_t			bulletMaskTests;
+	std::size_t			bulletHits;
+	sf::Time			time;
+};
+
+#endif // BOOK_COLLISIONSTATISTICS_HPP
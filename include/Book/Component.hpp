@@ -11,6 +11,8 @@ namespace sf
 	class Event;
 }
 
+class RenderSnapshot;
+
 namespace GUI
 {
 
@@ -29,6 +31,7 @@ class Component : public sf::Drawable, public sf::Transformable, private sf::Non
         virtual void		activate();
         virtual void		deactivate();
         virtual void		handleEvent(const sf::Event& event) = 0;
+        virtual void		snapshot(RenderSnapshot& snapshot, sf::RenderStates states) const = 0;
     private:
         bool				mIsSelected;
         bool				mIsActive;
@@ -17,6 +17,7 @@ class Container : public Component
         void				pack(Component::Ptr component);
         virtual bool		isSelectable() const;
         virtual void		handleEvent(const sf::Event& event);
+        virtual void		snapshot(RenderSnapshot& snapshot, sf::RenderStates states) const;
     private:
         virtual void		draw(sf::RenderTarget& target, sf::RenderStates states) const;
         bool				hasSelection() const;
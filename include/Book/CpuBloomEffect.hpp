@@ -0,0 +1,61 @@
+#ifndef BOOK_CPUBLOOMEFFECT_HPP
+#define BOOK_CPUBLOOMEFFECT_HPP
+
+#include <Book/PostEffect.hpp>
+#include <Book/BloomEffect.hpp>
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Clock.hpp>
+#include <vector>
+
+class JobSystem;
+
+// 不依赖着色器的泛光：读回场景图像，在CPU上用SIMD和多线程完成同样的处理链
+class CpuBloomEffect : public PostEffect
+{
+	public:
+		explicit			CpuBloomEffect(JobSystem& jobs);
+		virtual void		apply(const sf::RenderTexture& input, sf::RenderTarget& output);
+		void				setQuality(BloomEffect::Quality quality);
+		BloomEffect::Quality	getQuality() const;
+		void				setUpdateInterval(unsigned int frames);
+		void				setHistoryWeight(float weight);
+		const BloomEffect::Statistics&	getStatistics() const;
+	private:
+		struct Buffer
+		{
+			void				resize(unsigned int width, unsigned int height);
+			unsigned int		width;
+			unsigned int		height;
+			std::vector<float>	pixels;
+		};
+	private:
+		void				filterBrightDownSample(const sf::Uint8* source, unsigned int width, unsigned int height,
+								unsigned int divisor, Buffer& output);
+		void				downsample(const Buffer& input, Buffer& output);
+		void				blur(Buffer& buffer, Buffer& temporary);
+		void				blendHistory(float historyWeight);
+		void				composite(const sf::Uint8* source, unsigned int width, unsigned int height,
+								const Buffer& firstLevel, const Buffer& secondLevel);
+		void				present(const sf::RenderTexture& input, sf::RenderTarget& output, const sf::Texture& texture);
+		void				beginPass();
+		void				endPass(BloomEffect::PassType type);
+	private:
+		JobSystem&				mJobs;
+		BloomEffect::Quality	mQuality;
+		Buffer					mFirstLevel;
+		Buffer					mSecondLevel;
+		Buffer					mTemporary;
+		unsigned int			mUpdateInterval;
+		float					mHistoryWeight;
+		Buffer					mFirstHistory;
+		Buffer					mSecondHistory;
+		bool					mHistoryValid;
+		unsigned int			mFramesSinceUpdate;
+		std::vector<sf::Uint8>	mResultPixels;
+		sf::Texture				mResultTexture;
+		BloomEffect::Statistics	mStatistics;
+		sf::Clock				mPassClock;
+};
+
+#endif // BOOK_CPUBLOOMEFFECT_HPP
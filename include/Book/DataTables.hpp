@@ -27,6 +27,7 @@ struct AircraftData
 	float							speed;
 	Textures::ID					texture;
 	sf::IntRect						textureRect;
+	sf::FloatRect					hitBox;
 	sf::Time						fireInterval;
 	std::vector<Direction>			directions;
 	bool							hasRollAnimation;
@@ -38,6 +39,7 @@ struct ProjectileData
 	float							speed;
 	Textures::ID					texture;
 	sf::IntRect						textureRect;
+	sf::FloatRect					hitBox;
 };
 
 struct PickupData
@@ -45,6 +47,7 @@ struct PickupData
 	std::function<void(Aircraft&)>	action;
 	Textures::ID					texture;
 	sf::IntRect						textureRect;
+	sf::FloatRect					hitBox;
 };
 
 struct ParticleData
@@ -5,18 +5,18 @@
 #include <Book/Particle.hpp>
 
 class ParticleNode;
+class ParticleRegistry;
 
 class EmitterNode : public SceneNode
 {
 	public:
-		explicit				EmitterNode(Particle::Type type);
+								EmitterNode(Particle::Type type, const ParticleRegistry& particles);
 	private:
 		virtual void			updateCurrent(sf::Time dt, CommandQueue& commands);
 		void					emitParticles(sf::Time dt);
 	private:
 		sf::Time				mAccumulatedTime;
-		Particle::Type			mType;
-		ParticleNode*			mParticleSystem;
+		ParticleNode&			mParticleSystem;
 };
 
 #endif // BOOK_EMITTERNODE_HPP
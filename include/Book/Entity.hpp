@@ -2,11 +2,19 @@
 #define BOOK_ENTITY_HPP
 
 #include <Book/SceneNode.hpp>
+#include <Book/HitShape.hpp>
+#include <Book/CollisionMask.hpp>
 
+class EntityStore;
+class CollisionMaskAtlas;
+
+// 速度和生命值保存在 EntityStore 的连续数组中，节点本身只保留绘制所需的转换
 class Entity : public SceneNode
 {
+	friend class EntityStore;
 	public:
-		explicit			Entity(int hitpoints);
+							Entity(EntityStore& store, int hitpoints);
+		virtual				~Entity();
 		void				setVelocity(sf::Vector2f velocity);
 		void				setVelocity(float vx, float vy);
 		void				accelerate(sf::Vector2f velocity);
@@ -18,11 +26,17 @@ class Entity : public SceneNode
 		void				destroy();
 		virtual void		remove();
 		virtual bool		isDestroyed() const;
+		virtual void		steer(sf::Time dt);
+		virtual sf::FloatRect	getHitBox() const = 0;
+		HitShape			getHitShape() const;
+		sf::FloatRect		getHitBounds() const;
+		virtual sf::IntRect	getTextureRect() const = 0;
+		PlacedMask			getPlacedMask(const CollisionMaskAtlas& masks) const;
 	protected:
-		virtual void		updateCurrent(sf::Time dt, CommandQueue& commands);
+		EntityStore&		getStore() const;
 	private:
-		sf::Vector2f		mVelocity;
-		int					mHitpoints;
+		EntityStore&		mStore;
+		std::size_t			mStoreIndex;
 };
 
 #endif // BOOK_ENTITY_HPP
@@ -0,0 +1,66 @@
+#ifndef BOOK_ENTITYSTORE_HPP
+#define BOOK_ENTITYSTORE_HPP
+
+#include <Book/SceneNode.hpp>
+#include <Book/HitShape.hpp>
+#include <Book/CollisionMask.hpp>
+#include <Book/CollisionStatistics.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Config.hpp>
+#include <vector>
+
+class Entity;
+class CollisionDispatcher;
+class CollisionMaskAtlas;
+class JobSystem;
+
+// 实体组件的紧凑存储：速度、生命值、类别和碰撞框各占一个连续数组
+// 场景图只负责绘制层次，移动和碰撞由 World 按系统逐个数组遍历
+// 删除时用末尾元素填补空位，实体通过下标访问自己的组件
+// 实体被摧毁时登记到残骸列表，每步只检查列表中的实体并从父节点上摘除
+// 碰撞宽阶段按扫掠包围盒的上边排序后扫描，只测试纵向区间重叠的组合
+class EntityStore : private sf::NonCopyable
+{
+	friend class Entity;
+	public:
+		struct Contact
+		{
+			SceneNode*			first;
+			SceneNode*			second;
+			unsigned int		firstCategory;
+			unsigned int		secondCategory;
+		};
+	public:
+								EntityStore();
+		void					steer(sf::Time dt, JobSystem& jobs);
+		void					integrate(sf::Time dt, JobSystem& jobs);
+		void					updateColliders(const CollisionMaskAtlas& masks);
+		void					checkCollisions(const CollisionDispatcher& collisions, std::vector<Contact>& contacts,
+									CollisionStatistics& statistics) const;
+		void					removeWrecks();
+		std::size_t				getEntityCount() const;
+		Entity*					getEntity(std::size_t index) const;
+	private:
+		std::size_t				insert(Entity& owner, int hitpoints);
+		void					erase(std::size_t index);
+		void					addWreck(std::size_t index);
+	private:
+		std::vector<Entity*>		mOwners;
+		std::vector<sf::Vector2f>	mVelocities;
+		std::vector<int>			mHitpoints;
+		std::vector<unsigned int>	mCategories;
+		std::vector<sf::FloatRect>	mColliders;
+		std::vector<HitShape>		mHitShapes;
+		std::vector<PlacedMask>		mMasks;
+		std::vector<sf::Vector2f>	mDisplacements;
+		std::vector<sf::Uint8>		mPendingRemoval;
+		std::vector<Entity*>		mWrecks;
+		std::vector<SceneNode*>		mWreckParents;
+		std::vector<sf::FloatRect>	mSweptBounds;
+		std::vector<std::size_t>	mSweepOrder;
+};
+
+#endif // BOOK_ENTITYSTORE_HPP
@@ -0,0 +1,55 @@
+#ifndef BOOK_FRAMEBUDGETMONITOR_HPP
+#define BOOK_FRAMEBUDGETMONITOR_HPP
+
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Clock.hpp>
+#include <array>
+#include <vector>
+#include <string>
+
+class FrameBudgetMonitor
+{
+	public:
+		enum Phase
+		{
+			Input,
+			Update,
+			Render,
+			Present,
+			PhaseCount
+		};
+		struct Record
+		{
+			std::size_t							frame;
+			sf::Time							workTime;
+			std::array<sf::Time, PhaseCount>	phases;
+			std::size_t							updateSteps;
+			sf::Time							droppedTime;
+		};
+	public:
+		explicit								FrameBudgetMonitor(sf::Time budget, std::size_t maxRecords = 10000);
+		void									beginFrame();
+		void									beginPhase(Phase phase);
+		void									endPhase();
+		void									addUpdateStep();
+		void									addDroppedTime(sf::Time time);
+		void									endFrame();
+		const Record&							getLastFrame() const;
+		const std::vector<Record>&				getOverruns() const;
+		std::size_t								getFrameCount() const;
+		sf::Time								getTotalDroppedTime() const;
+		bool									writeReport(const std::string& filename) const;
+	private:
+		sf::Time								mBudget;
+		std::size_t								mMaxRecords;
+		std::size_t								mFrameCount;
+		std::size_t								mUnrecordedOverruns;
+		sf::Time								mTotalDroppedTime;
+		Record									mCurrent;
+		Record									mLastFrame;
+		Phase									mCurrentPhase;
+		sf::Clock								mPhaseClock;
+		std::vector<Record>						mOverruns;
+};
+
+#endif // BOOK_FRAMEBUDGETMONITOR_HPP
@@ -0,0 +1,20 @@
+#ifndef BOOK_FRAMELIMITER_HPP
+#define BOOK_FRAMELIMITER_HPP
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+
+class FrameLimiter
+{
+	public:
+		explicit			FrameLimiter(unsigned int framerate, sf::Time spinThreshold = sf::milliseconds(2));
+		void				setFramerate(unsigned int framerate);
+		void				wait();
+	private:
+		sf::Clock			mClock;
+		sf::Time			mFrameTime;
+		sf::Time			mSpinThreshold;
+		sf::Time			mNextFrame;
+};
+
+#endif // BOOK_FRAMELIMITER_HPP
@@ -10,9 +10,11 @@ class GameOverState : public State
 {
 	public:
 							GameOverState(StateStack& stack, Context context);
-		virtual void		draw();
+		virtual void		draw(float interpolation);
+		virtual void		snapshot(RenderSnapshot& snapshot, float interpolation);
 		virtual bool		update(sf::Time dt);
 		virtual bool		handleEvent(const sf::Event& event);
+		virtual bool		freezesStatesBelow() const;
 	private:
 		sf::Text			mGameOverText;
 		sf::Time			mElapsedTime;
@@ -11,9 +11,13 @@ class GameState : public State
 {
 	public:
 							GameState(StateStack& stack, Context context);
-		virtual void		draw();
+							~GameState();
+		virtual void		draw(float interpolation);
+		virtual void		snapshot(RenderSnapshot& snapshot, float interpolation);
 		virtual bool		update(sf::Time dt);
 		virtual bool		handleEvent(const sf::Event& event);
+		virtual bool		isOpaque() const;
+		virtual bool		isAnimated() const;
 	private:
 		World				mWorld;
 		Player&				mPlayer;
@@ -0,0 +1,59 @@
+#ifndef BOOK_GRAPHICSSETTINGS_HPP
+#define BOOK_GRAPHICSSETTINGS_HPP
+
+#include <Book/BloomEffect.hpp>
+
+class GraphicsSettings
+{
+	public:
+		enum BloomDevice
+		{
+			AutomaticDevice,
+			GpuDevice,
+			CpuDevice,
+			BloomDeviceCount
+		};
+	public:
+										GraphicsSettings();
+		void							setBloomQuality(BloomEffect::Quality quality);
+		BloomEffect::Quality			getBloomQuality() const;
+		void							setBloomDevice(BloomDevice device);
+		BloomDevice						getBloomDevice() const;
+		bool							usesCpuBloom() const;
+		void							setBloomUpdateInterval(unsigned int frames);
+		unsigned int					getBloomUpdateInterval() const;
+		void							setBloomHistoryWeight(float weight);
+		float							getBloomHistoryWeight() const;
+		static const char*				getBloomDeviceName(BloomDevice device);
+		void							setBloomStatistics(const BloomEffect::Statistics& statistics);
+		const BloomEffect::Statistics&	getBloomStatistics() const;
+		void							setDynamicResolutionEnabled(bool flag);
+		bool							isDynamicResolutionEnabled() const;
+		void							setResolutionScale(float scale);
+		float							getResolutionScale() const;
+		void							setVerticalSyncEnabled(bool flag);
+		bool							isVerticalSyncEnabled() const;
+		void							setFramerateLimit(unsigned int framerate);
+		unsigned int					getFramerateLimit() const;
+		void							setMaxUpdatesPerFrame(std::size_t steps);
+		std::size_t						getMaxUpdatesPerFrame() const;
+		void							setStatisticsVisible(bool flag);
+		bool							isStatisticsVisible() const;
+		void							setRenderThreadEnabled(bool flag);
+		bool							isRenderThreadEnabled() const;
+	private:
+		BloomEffect::Quality			mBloomQuality;
+		BloomDevice						mBloomDevice;
+		unsigned int					mBloomUpdateInterval;
+		float							mBloomHistoryWeight;
+		BloomEffect::Statistics			mBloomStatistics;
+		bool							mDynamicResolution;
+		float							mResolutionScale;
+		bool							mVerticalSync;
+		unsigned int					mFramerateLimit;
+		std::size_t						mMaxUpdatesPerFrame;
+		bool							mStatisticsVisible;
+		bool							mRenderThread;
+};
+
+#endif // BOOK_GRAPHICSSETTINGS_HPP
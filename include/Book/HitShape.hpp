@@ -0,0 +1,18 @@
+#ifndef BOOK_HITSHAPE_HPP
+#define BOOK_HITSHAPE_HPP
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Transform.hpp>
+
+// 世界坐标下的有向矩形碰撞框，按顺序保存四个角点，x、y 分开存放便于向量化
+struct HitShape
+{
+	float			x[4];
+	float			y[4];
+};
+
+HitShape		makeHitShape(const sf::Transform& transform, const sf::FloatRect& localRect);
+sf::FloatRect	getBounds(const HitShape& shape);
+bool			intersects(const HitShape& lhs, const HitShape& rhs);
+
+#endif // BOOK_HITSHAPE_HPP
@@ -0,0 +1,54 @@
+#ifndef BOOK_JOBSYSTEM_HPP
+#define BOOK_JOBSYSTEM_HPP
+
+#include <SFML/System/NonCopyable.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 工作线程各有一个队列，每个调用 parallelFor 的外部线程（主线程、渲染线程）也各占一个队列
+// 调用线程在等待本批区间完成时帮忙执行，工作线程不能再调用 parallelFor
+// 外部线程结束前调用 unregisterCaller 归还队列；队列用完时 parallelFor 退化为在调用线程上顺序执行
+class JobSystem : private sf::NonCopyable
+{
+	public:
+		typedef std::function<void(std::size_t, std::size_t)> RangeJob;
+	public:
+		explicit				JobSystem(std::size_t threadCount = 0);
+								~JobSystem();
+		void					parallelFor(std::size_t count, std::size_t grainSize, const RangeJob& job);
+		void					unregisterCaller();
+		std::size_t				getThreadCount() const;
+	private:
+		typedef std::function<void()> Job;
+		struct WorkQueue
+		{
+			std::mutex			mutex;
+			std::deque<Job>		jobs;
+		};
+	private:
+		void					push(std::size_t queueIndex, Job job);
+		bool					pop(std::size_t queueIndex, Job& job);
+		bool					steal(std::size_t thiefIndex, Job& job);
+		bool					acquireCallerQueue(std::size_t& queueIndex);
+		bool					isWorkerThread() const;
+		void					workerLoop(std::size_t queueIndex);
+	private:
+		static const std::size_t				MaxCallerThreads;
+		std::vector<std::unique_ptr<WorkQueue>>	mQueues;
+		std::vector<std::thread>				mWorkers;
+		std::mutex								mCallerMutex;
+		std::map<std::thread::id, std::size_t>	mCallerQueues;
+		std::mutex								mWakeMutex;
+		std::condition_variable					mWakeCondition;
+		std::atomic<std::size_t>				mQueuedJobs;
+		bool									mShutdown;
+};
+
+#endif // BOOK_JOBSYSTEM_HPP
@@ -18,6 +18,7 @@ class Label : public Component
         virtual bool		isSelectable() const;
 		void				setText(const std::string& text);
         virtual void		handleEvent(const sf::Event& event);
+        virtual void		snapshot(RenderSnapshot& snapshot, sf::RenderStates states) const;
     private:
         void				draw(sf::RenderTarget& target, sf::RenderStates states) const;
     private:
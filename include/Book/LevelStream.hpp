@@ -0,0 +1,60 @@
+#ifndef BOOK_LEVELSTREAM_HPP
+#define BOOK_LEVELSTREAM_HPP
+
+#include <SFML/Config.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// 关卡事件，distance 为从起点向上的触发距离，x 为相对地图中线的水平偏移
+struct LevelEvent
+{
+	enum Type
+	{
+		SpawnEnemy,
+		SpawnWave,
+		SpawnPickup,
+		ChangeScrollSpeed,
+		TypeCount
+	};
+	float			distance;
+	float			x;
+	float			value;		// 波次中敌机的水平间距，或新的滚动速度
+	sf::Uint8		type;
+	sf::Uint8		subtype;	// Aircraft::Type 或 Pickup::Type
+	sf::Uint16		count;		// 波次中的敌机数量
+};
+
+// 二进制关卡文件：20字节文件头（"SLVL"、版本、事件数、初始滚动速度、关卡长度）
+// 之后是按 distance 升序排列的16字节事件记录，全部为小端序；版本1的文件头没有关卡长度
+// 打开时只读取文件头，事件按块顺序读入，文件缺失时使用内置关卡
+// writeToFile 总是写出有序的文件；读入时每块单独排序，比上一块更早的事件推迟到上一块末尾触发
+class LevelStream : private sf::NonCopyable
+{
+	public:
+		explicit				LevelStream(const std::string& filename);
+		bool					hasPendingEvent() const;
+		const LevelEvent&		peekEvent() const;
+		void					popEvent();
+		float					getScrollSpeed() const;
+		float					getLevelLength() const;
+		std::size_t				getEventCount() const;
+		static bool				writeToFile(const std::string& filename, float scrollSpeed, float levelLength,
+									std::vector<LevelEvent> events);
+	private:
+		bool					readHeader();
+		void					fillBuffer();
+		void					loadDefaultLevel();
+	private:
+		std::ifstream			mFile;
+		std::vector<LevelEvent>	mBuffer;
+		std::size_t				mBufferPosition;
+		std::size_t				mUnreadEvents;
+		std::size_t				mEventCount;
+		float					mScrollSpeed;
+		float					mLevelLength;
+		float					mLastDistance;
+};
+
+#endif // BOOK_LEVELSTREAM_HPP
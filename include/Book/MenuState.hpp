@@ -10,9 +10,11 @@ class MenuState : public State
 {
 	public:
 								MenuState(StateStack& stack, Context context);
-		virtual void			draw();
+		virtual void			draw(float interpolation);
+		virtual void			snapshot(RenderSnapshot& snapshot, float interpolation);
 		virtual bool			update(sf::Time dt);
 		virtual bool			handleEvent(const sf::Event& event);
+		virtual bool			isOpaque() const;
 	private:
 		sf::Sprite				mBackgroundSprite;
 		GUI::Container			mGUIContainer;
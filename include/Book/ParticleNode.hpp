@@ -7,16 +7,19 @@
 #include <SFML/Graphics/VertexArray.hpp>
 #include <deque>
 
+class JobSystem;
+
 class ParticleNode : public SceneNode
 {
 	public:
 								ParticleNode(Particle::Type type, const TextureHolder& textures);
-		void					addParticle(sf::Vector2f position);
+		void					addParticles(sf::Vector2f position, std::size_t count);
 		Particle::Type			getParticleType() const;
 		virtual unsigned int	getCategory() const;
+		void					updateParticles(sf::Time dt, JobSystem& jobs);
 	private:
-		virtual void			updateCurrent(sf::Time dt, CommandQueue& commands);
 		virtual void			drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
+		virtual void			snapshotCurrent(RenderSnapshot& snapshot, sf::RenderStates states) const;
 		void					addVertex(float worldX, float worldY, float texCoordX, float texCoordY, const sf::Color& color) const;
 		void					computeVertices() const;
 	private:
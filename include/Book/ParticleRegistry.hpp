@@ -0,0 +1,21 @@
+#ifndef BOOK_PARTICLEREGISTRY_HPP
+#define BOOK_PARTICLEREGISTRY_HPP
+
+#include <Book/Particle.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <array>
+
+class ParticleNode;
+
+// 按粒子类型登记的粒子节点，发射节点创建时直接取得对应的粒子系统
+class ParticleRegistry : private sf::NonCopyable
+{
+	public:
+								ParticleRegistry();
+		void					registerNode(ParticleNode& node);
+		ParticleNode&			get(Particle::Type type) const;
+	private:
+		std::array<ParticleNode*, Particle::ParticleCount>	mNodes;
+};
+
+#endif // BOOK_PARTICLEREGISTRY_HPP
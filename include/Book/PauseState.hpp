@@ -11,9 +11,11 @@ class PauseState : public State
 	public:
 							PauseState(StateStack& stack, Context context);
 							~PauseState();
-		virtual void		draw();
+		virtual void		draw(float interpolation);
+		virtual void		snapshot(RenderSnapshot& snapshot, float interpolation);
 		virtual bool		update(sf::Time dt);
 		virtual bool		handleEvent(const sf::Event& event);
+		virtual bool		freezesStatesBelow() const;
 	private:
 		sf::Sprite			mBackgroundSprite;
 		sf::Text			mPausedText;
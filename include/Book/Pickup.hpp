@@ -20,12 +20,15 @@ class Pickup : public Entity
 			TypeCount
 		};
 	public:
-								Pickup(Type type, const TextureHolder& textures);
+								Pickup(Type type, const TextureHolder& textures, EntityStore& entities);
 		virtual unsigned int	getCategory() const;
 		virtual sf::FloatRect	getBoundingRect() const;
+		virtual sf::FloatRect	getHitBox() const;
+		virtual sf::IntRect		getTextureRect() const;
 		void 					apply(Aircraft& player) const;
 	protected:
 		virtual void			drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
+		virtual void			snapshotCurrent(RenderSnapshot& snapshot, sf::RenderStates states) const;
 	private:
 		Type 					mType;
 		sf::Sprite				mSprite;
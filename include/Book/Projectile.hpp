@@ -5,6 +5,8 @@
 #include <Book/ResourceIdentifiers.hpp>
 #include <SFML/Graphics/Sprite.hpp>
 
+class ParticleRegistry;
+
 class Projectile : public Entity
 {
 	public:
@@ -16,16 +18,19 @@ class Projectile : public Entity
 			TypeCount
 		};
 	public:
-								Projectile(Type type, const TextureHolder& textures);
+								Projectile(Type type, const TextureHolder& textures, EntityStore& entities, const ParticleRegistry& particles);
 		void					guideTowards(sf::Vector2f position);
 		bool					isGuided() const;
 		virtual unsigned int	getCategory() const;
 		virtual sf::FloatRect	getBoundingRect() const;
+		virtual sf::FloatRect	getHitBox() const;
+		virtual sf::IntRect		getTextureRect() const;
 		float					getMaxSpeed() const;
 		int						getDamage() const;
+		virtual void			steer(sf::Time dt);
 	private:
-		virtual void			updateCurrent(sf::Time dt, CommandQueue& commands);
 		virtual void			drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
+		virtual void			snapshotCurrent(RenderSnapshot& snapshot, sf::RenderStates states) const;
 	private:
 		Type					mType;
 		sf::Sprite				mSprite;
@@ -0,0 +1,21 @@
+#ifndef BOOK_RANDOMGENERATOR_HPP
+#define BOOK_RANDOMGENERATOR_HPP
+
+#include <SFML/Config.hpp>
+
+// PCG32 随机数生成器：64位状态，同一种子总是产生相同的序列
+// 每个 World 持有自己的生成器，互不共享状态
+class RandomGenerator
+{
+	public:
+		explicit				RandomGenerator(sf::Uint64 seed);
+		void					setSeed(sf::Uint64 seed);
+		sf::Uint64				getSeed() const;
+		sf::Uint32				next();
+		int						nextInt(int exclusiveMax);
+	private:
+		sf::Uint64				mSeed;
+		sf::Uint64				mState;
+};
+
+#endif // BOOK_RANDOMGENERATOR_HPP
@@ -0,0 +1,51 @@
+#ifndef BOOK_RENDERSNAPSHOT_HPP
+#define BOOK_RENDERSNAPSHOT_HPP
+
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <vector>
+#include <memory>
+
+namespace sf
+{
+	class RenderTarget;
+	class Text;
+}
+
+// 一帧的只读绘制数据，保存可绘制对象的副本，可以交给渲染线程
+// 文字在记录时展开成字形四边形，渲染线程只读取字体纹理，不调用 sf::Font
+class RenderSnapshot : private sf::NonCopyable
+{
+	public:
+								RenderSnapshot();
+		void					clear();
+		bool					isEmpty() const;
+		void					setSceneView(const sf::View& view);
+		template <typename Drawable>
+		void					addToScene(const Drawable& drawable, const sf::RenderStates& states = sf::RenderStates::Default);
+		template <typename Drawable>
+		void					addToOverlay(const Drawable& drawable, const sf::RenderStates& states = sf::RenderStates::Default);
+		void					addToScene(const sf::Text& text, const sf::RenderStates& states = sf::RenderStates::Default);
+		void					addToOverlay(const sf::Text& text, const sf::RenderStates& states = sf::RenderStates::Default);
+		bool					hasScene() const;
+		void					drawScene(sf::RenderTarget& target) const;
+		void					drawOverlay(sf::RenderTarget& target) const;
+	private:
+		struct Item
+		{
+			std::unique_ptr<sf::Drawable>	drawable;
+			sf::RenderStates				states;
+		};
+	private:
+		static void				addText(std::vector<Item>& items, const sf::Text& text, sf::RenderStates states);
+		static void				drawItems(const std::vector<Item>& items, sf::RenderTarget& target);
+	private:
+		sf::View				mSceneView;
+		std::vector<Item>		mSceneItems;
+		std::vector<Item>		mOverlayItems;
+};
+
+#include <Book/RenderSnapshot.inl>
+#endif // BOOK_RENDERSNAPSHOT_HPP
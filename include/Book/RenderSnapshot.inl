@@ -0,0 +1,17 @@
+template <typename Drawable>
+void RenderSnapshot::addToScene(const Drawable& drawable, const sf::RenderStates& states)
+{
+	Item item;
+	item.drawable.reset(new Drawable(drawable));
+	item.states = states;
+	mSceneItems.push_back(std::move(item));
+}
+
+template <typename Drawable>
+void RenderSnapshot::addToOverlay(const Drawable& drawable, const sf::RenderStates& states)
+{
+	Item item;
+	item.drawable.reset(new Drawable(drawable));
+	item.states = states;
+	mOverlayItems.push_back(std::move(item));
+}
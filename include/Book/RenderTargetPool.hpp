@@ -0,0 +1,41 @@
+#ifndef BOOK_RENDERTARGETPOOL_HPP
+#define BOOK_RENDERTARGETPOOL_HPP
+
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <memory>
+#include <vector>
+
+class RenderTargetPool : private sf::NonCopyable
+{
+	public:
+		explicit					RenderTargetPool(std::size_t memoryBudget = 32 * 1024 * 1024, unsigned int maxIdleFrames = 120);
+		sf::RenderTexture&			acquire(sf::Vector2u size, bool depthBuffer = false);
+		void						release(sf::RenderTexture& target);
+		void						endFrame();
+		std::size_t					getTargetCount() const;
+		std::size_t					getMemoryUsage() const;
+	private:
+		struct Entry
+		{
+			sf::Vector2u			size;
+			bool					depthBuffer;
+			bool					inUse;
+			unsigned int			lastUsedFrame;
+			sf::RenderTexture		texture;
+		};
+		typedef std::unique_ptr<Entry> EntryPtr;
+	private:
+		static std::size_t			getEntrySize(sf::Vector2u size, bool depthBuffer);
+		bool						evictLeastRecentlyUsed();
+		void						erase(std::size_t index);
+	private:
+		std::vector<EntryPtr>		mEntries;
+		std::size_t					mMemoryBudget;
+		std::size_t					mMemoryUsage;
+		unsigned int				mMaxIdleFrames;
+		unsigned int				mFrame;
+};
+
+#endif // BOOK_RENDERTARGETPOOL_HPP
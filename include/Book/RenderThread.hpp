@@ -0,0 +1,72 @@
+#ifndef BOOK_RENDERTHREAD_HPP
+#define BOOK_RENDERTHREAD_HPP
+
+#include <Book/RenderSnapshot.hpp>
+#include <Book/BloomEffect.hpp>
+#include <Book/CpuBloomEffect.hpp>
+#include <Book/GraphicsSettings.hpp>
+#include <Book/RenderTargetPool.hpp>
+#include <Book/FrameLimiter.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace sf
+{
+	class RenderWindow;
+}
+
+class JobSystem;
+
+// 在单独的线程中绘制主线程发布的快照，泛光、动态分辨率和渲染目标都由本线程自己管理
+// 快照路径不使用冻结画面；文字只读取字体纹理，界面用到的字号需要预先载入字形
+// 发布快照从不等待渲染线程，没被取走的快照直接被新的覆盖；帧率由本线程的垂直同步或限制器控制
+class RenderThread : private sf::NonCopyable
+{
+	public:
+		struct Statistics
+		{
+			BloomEffect::Statistics		bloom;
+			std::size_t					targetCount;
+			std::size_t					targetMemory;
+			sf::Time					renderTime;
+			std::size_t					frameCount;		// 已画完的帧数，用来区分新的渲染时间和重复读到的旧值
+		};
+	public:
+										RenderThread(sf::RenderWindow& window, JobSystem& jobs);
+										~RenderThread();
+		void							stop();
+		RenderSnapshot&					getBackSnapshot();
+		void							publish();
+		void							flush();
+		void							setGraphicsSettings(const GraphicsSettings& graphics);
+		Statistics						getStatistics() const;
+	private:
+		void							run();
+		void							render(const RenderSnapshot& snapshot, const GraphicsSettings& graphics);
+		void							drawScene(const RenderSnapshot& snapshot, const GraphicsSettings& graphics);
+	private:
+		sf::RenderWindow&				mWindow;
+		JobSystem&						mJobs;
+		RenderTargetPool				mRenderTargets;
+		BloomEffect						mBloomEffect;
+		CpuBloomEffect					mCpuBloomEffect;
+		GraphicsSettings				mGraphics;
+		FrameLimiter					mFrameLimiter;
+		Statistics						mStatistics;
+		std::array<RenderSnapshot, 3>	mSnapshots;
+		std::size_t						mBackIndex;
+		std::size_t						mReadyIndex;
+		std::size_t						mFrontIndex;
+		bool							mHasNewSnapshot;
+		bool							mRunning;
+		mutable std::mutex				mMutex;
+		std::mutex						mFrameMutex;
+		std::condition_variable			mCondition;
+		std::thread						mThread;
+};
+
+#endif // BOOK_RENDERTHREAD_HPP
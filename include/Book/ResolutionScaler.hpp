@@ -0,0 +1,32 @@
+#ifndef BOOK_RESOLUTIONSCALER_HPP
+#define BOOK_RESOLUTIONSCALER_HPP
+
+#include <SFML/System/Time.hpp>
+
+// 按实测的渲染时间（CPU提交加GPU完成，不含休眠和垂直同步等待）调整场景分辨率
+class ResolutionScaler
+{
+	public:
+		explicit			ResolutionScaler(sf::Time targetFrameTime, float minScale = 0.5f, float step = 0.125f);
+		void				setTargetFrameTime(sf::Time targetFrameTime);
+		void				addFrame(sf::Time renderTime);
+		void				reset();
+		float				getScale() const;
+	private:
+		void				changeScale(float delta);
+	private:
+		static const std::size_t	SampleFrames;
+		static const float			Tolerance;
+		static const std::size_t	MaxUpscaleDelay;
+		sf::Time			mTargetFrameTime;
+		float				mMinScale;
+		float				mStep;
+		float				mScale;
+		sf::Time			mAccumulatedTime;
+		std::size_t			mSampleCount;
+		std::size_t			mStableWindows;
+		std::size_t			mUpscaleDelay;
+		bool				mLastChangeWasUpscale;
+};
+
+#endif // BOOK_RESOLUTIONSCALER_HPP
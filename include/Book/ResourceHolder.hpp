@@ -14,6 +14,8 @@ class ResourceHolder
 		void						load(Identifier id, const std::string& filename);
 		template <typename Parameter>
 		void						load(Identifier id, const std::string& filename, const Parameter& secondParam);
+		template <typename Parameter>
+		void						loadFromMemory(Identifier id, const std::string& data, const Parameter& secondParam);
 		Resource&					get(Identifier id);
 		const Resource&				get(Identifier id) const;
 	private:
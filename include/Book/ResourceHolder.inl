@@ -17,6 +17,16 @@ void ResourceHolder<Resource, Identifier>::load(Identifier id, const std::string
 	insertResource(id, std::move(resource));
 }
 
+template <typename Resource, typename Identifier>
+template <typename Parameter>
+void ResourceHolder<Resource, Identifier>::loadFromMemory(Identifier id, const std::string& data, const Parameter& secondParam)
+{
+	std::unique_ptr<Resource> resource(new Resource());
+	if (!resource->loadFromMemory(data, secondParam))
+		throw std::runtime_error("ResourceHolder::loadFromMemory - Failed to load resource from memory");
+	insertResource(id, std::move(resource));
+}
+
 template <typename Resource, typename Identifier>
 Resource& ResourceHolder<Resource, Identifier>::get(Identifier id)
 {
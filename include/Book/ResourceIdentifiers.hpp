@@ -30,7 +30,9 @@ namespace Shaders
 		BrightnessPass,
 		DownSamplePass,
 		GaussianBlurPass,
-		AddPass,
+		BrightDownSamplePass,
+		CompositePass,
+		TemporalBlendPass,
 	};
 }
 
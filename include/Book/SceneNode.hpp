@@ -7,30 +7,33 @@
 #include <SFML/Graphics/Transformable.hpp>
 #include <SFML/Graphics/Drawable.hpp>
 #include <vector>
-#include <set>
 #include <memory>
 #include <utility>
 
 struct Command;
 class CommandQueue;
+class RenderSnapshot;
 
 class SceneNode : public sf::Transformable, public sf::Drawable, private sf::NonCopyable
 {
 	public:
 		typedef std::unique_ptr<SceneNode> Ptr;
-		typedef std::pair<SceneNode*, SceneNode*> Pair;
 	public:
 		explicit				SceneNode(Category::Type category = Category::None);
 		void					attachChild(Ptr child);
 		Ptr						detachChild(const SceneNode& node);
+		Ptr						releaseChild(const SceneNode& node);
+		void					compactChildren();
+		SceneNode*				getParent() const;
 		void					update(sf::Time dt, CommandQueue& commands);
 		sf::Vector2f			getWorldPosition() const;
 		sf::Transform			getWorldTransform() const;
+		void					savePreviousTransform();
+		sf::Transform			getInterpolatedTransform(float alpha) const;
+		void					drawInterpolated(sf::RenderTarget& target, sf::RenderStates states, float alpha) const;
 		void					onCommand(const Command& command, sf::Time dt);
+		void					snapshot(RenderSnapshot& snapshot, sf::RenderStates states, float alpha) const;
 		virtual unsigned int	getCategory() const;
-		void					checkSceneCollision(SceneNode& sceneGraph, std::set<Pair>& collisionPairs);
-		void					checkNodeCollision(SceneNode& node, std::set<Pair>& collisionPairs);
-		void					removeWrecks();
 		virtual sf::FloatRect	getBoundingRect() const;
 		virtual bool			isMarkedForRemoval() const;
 		virtual bool			isDestroyed() const;
@@ -39,12 +42,19 @@ class SceneNode : public sf::Transformable, public sf::Drawable, private sf::Non
 		void					updateChildren(sf::Time dt, CommandQueue& commands);
 		virtual void			draw(sf::RenderTarget& target, sf::RenderStates states) const;
 		virtual void			drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
-		void					drawChildren(sf::RenderTarget& target, sf::RenderStates states) const;
+		virtual void			drawCurrentInterpolated(sf::RenderTarget& target, sf::RenderStates states, float alpha) const;
+		void					drawChildren(sf::RenderTarget& target, sf::RenderStates states, float alpha) const;
+		virtual void			snapshotCurrent(RenderSnapshot& snapshot, sf::RenderStates states) const;
+		virtual void			snapshotCurrentInterpolated(RenderSnapshot& snapshot, sf::RenderStates states, float alpha) const;
 		void					drawBoundingRect(sf::RenderTarget& target, sf::RenderStates states) const;
 	private:
 		std::vector<Ptr>		mChildren;
 		SceneNode*				mParent;
+		std::size_t				mIndexInParent;
 		Category::Type			mDefaultCategory;
+		sf::Vector2f			mPreviousPosition;
+		float					mPreviousRotation;
+		bool					mHasPreviousTransform;
 };
 
 bool	collision(const SceneNode& lhs, const SceneNode& rhs);
@@ -15,17 +15,33 @@ class SettingsState : public State
 {
 	public:
 										SettingsState(StateStack& stack, Context context);
-		virtual void					draw();
+		virtual void					draw(float interpolation);
+		virtual void					snapshot(RenderSnapshot& snapshot, float interpolation);
 		virtual bool					update(sf::Time dt);
 		virtual bool					handleEvent(const sf::Event& event);
+		virtual bool					isOpaque() const;
 	private:
 		void							updateLabels();
+		void							updateBloomLabel();
+		void							updateResolutionLabel();
+		void							updateBloomDeviceLabel();
+		void							updateBloomRateLabel();
+		void							updateRenderThreadLabel();
+		void							updateFramerateLabel();
+		void							updateStatisticsLabel();
 		void							addButtonLabel(Player::Action action, float y, const std::string& text, Context context);
 	private:
 		sf::Sprite											mBackgroundSprite;
 		GUI::Container										mGUIContainer;
 		std::array<GUI::Button::Ptr, Player::ActionCount>	mBindingButtons;
 		std::array<GUI::Label::Ptr, Player::ActionCount> 	mBindingLabels;
+		GUI::Button::Ptr									mBloomButton;
+		GUI::Button::Ptr									mResolutionButton;
+		GUI::Button::Ptr									mBloomDeviceButton;
+		GUI::Button::Ptr									mBloomRateButton;
+		GUI::Button::Ptr									mRenderThreadButton;
+		GUI::Button::Ptr									mFramerateButton;
+		GUI::Button::Ptr									mStatisticsButton;
 };
 
 #endif // BOOK_SETTINGSSTATE_HPP
@@ -11,6 +11,7 @@ class SpriteNode : public SceneNode
 							SpriteNode(const sf::Texture& texture, const sf::IntRect& textureRect);
 	private:
 		virtual void		drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
+		virtual void		snapshotCurrent(RenderSnapshot& snapshot, sf::RenderStates states) const;
 	private:
 		sf::Sprite			mSprite;
 };
@@ -16,6 +16,11 @@ class StateStack;
 class Player;
 class MusicPlayer;
 class SoundPlayer;
+class JobSystem;
+class GraphicsSettings;
+class RenderTargetPool;
+class RenderSnapshot;
+struct CollisionStatistics;
 
 class State
 {
@@ -24,28 +29,42 @@ class State
 		struct Context
 		{
 								Context(sf::RenderWindow& window, TextureHolder& textures, FontHolder& fonts, Player& player,
-									MusicPlayer& music, SoundPlayer& sounds);
+									MusicPlayer& music, SoundPlayer& sounds, JobSystem& jobs, GraphicsSettings& graphics,
+									RenderTargetPool& renderTargets, CollisionStatistics& collisions, sf::Uint64 seed);
 			sf::RenderWindow*	window;
 			TextureHolder*		textures;
 			FontHolder*			fonts;
 			Player*				player;
 			MusicPlayer*		music;
 			SoundPlayer*		sounds;
+			JobSystem*			jobs;
+			GraphicsSettings*	graphics;
+			RenderTargetPool*	renderTargets;
+			CollisionStatistics*	collisions;
+			sf::Uint64			seed;		// 关卡随机数种子，0 表示按当前时间
 		};
 	public:
 							State(StateStack& stack, Context context);
 		virtual				~State();
-		virtual void		draw() = 0;
+		virtual void		draw(float interpolation) = 0;
+		virtual void		snapshot(RenderSnapshot& snapshot, float interpolation) = 0;
 		virtual bool		update(sf::Time dt) = 0;
 		virtual bool		handleEvent(const sf::Event& event) = 0;
+		virtual bool		freezesStatesBelow() const;
+		virtual bool		isOpaque() const;
+		virtual bool		isAnimated() const;
+		bool				needsRedraw() const;
+		void				markDrawn();
 	protected:
 		void				requestStackPush(States::ID stateID);
 		void				requestStackPop();
 		void				requestStateClear();
+		void				requestRedraw();
 		Context				getContext() const;
 	private:
 		StateStack*			mStack;
 		Context				mContext;
+		bool				mNeedsRedraw;
 };
 
 #endif // BOOK_STATE_HPP
@@ -6,6 +6,8 @@
 #include <Book/ResourceIdentifiers.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Time.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Sprite.hpp>
 #include <vector>
 #include <utility>
 #include <functional>
@@ -32,15 +34,23 @@ class StateStack : private sf::NonCopyable
 		template <typename T>
 		void				registerState(States::ID stateID);
 		void				update(sf::Time dt);
-		void				draw();
+		void				draw(float interpolation);
+		void				snapshot(RenderSnapshot& snapshot, float interpolation);
 		void				handleEvent(const sf::Event& event);
 		void				pushState(States::ID stateID);
 		void				popState();
 		void				clearStates();
 		bool				isEmpty() const;
+		bool				needsRedraw() const;
+		void				requestRedraw();
+		void				setChangeCallback(std::function<void()> callback);
 	private:
 		State::Ptr			createState(States::ID stateID);
 		void				applyPendingChanges();
+		std::size_t			getFirstVisibleState() const;
+		std::size_t			getFrozenStateCount() const;
+		void				captureFrozenFrame(std::size_t begin, std::size_t end, float interpolation);
+		void				drawFrozenFrame();
 	private:
 		struct PendingChange
 		{
@@ -53,6 +63,11 @@ class StateStack : private sf::NonCopyable
 		std::vector<PendingChange>							mPendingList;
 		State::Context										mContext;
 		std::map<States::ID, std::function<State::Ptr()>>	mFactories;
+		std::function<void()>								mChangeCallback;
+		bool												mNeedsRedraw;
+		sf::Texture											mFrozenTexture;
+		sf::Sprite											mFrozenSprite;
+		bool												mFrozenFrameValid;
 };
 
 template <typename T>
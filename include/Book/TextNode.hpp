@@ -14,6 +14,7 @@ class TextNode : public SceneNode
 		void				setString(const std::string& text);
 	private:
 		virtual void		drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
+		virtual void		snapshotCurrent(RenderSnapshot& snapshot, sf::RenderStates states) const;
 	private:
 		sf::Text			mText;
 };
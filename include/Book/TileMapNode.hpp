@@ -0,0 +1,50 @@
+#ifndef BOOK_TILEMAPNODE_HPP
+#define BOOK_TILEMAPNODE_HPP
+
+#include <Book/SceneNode.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <deque>
+#include <fstream>
+#include <string>
+
+namespace sf
+{
+	class Texture;
+}
+
+// 分块的平铺背景：只为视野附近的块生成顶点，块的定义从关卡文件中按需读取
+// 关卡文件每行一排图块编号，从关卡起点（底部）开始向上排列，'#' 开头的行为注释
+// 编号0表示按世界坐标连续平铺的基础纹理，n>0表示图块集中第n-1个图块
+class TileMapNode : public SceneNode
+{
+	public:
+							TileMapNode(const sf::Texture& tileset, const std::string& filename, sf::FloatRect bounds,
+								float tileSize = 64.f, std::size_t chunkRows = 8);
+		void				stream(sf::FloatRect viewBounds);
+		std::size_t			getLoadedChunkCount() const;
+	private:
+		struct Chunk
+		{
+			std::size_t		index;
+			sf::VertexArray	vertices;
+		};
+	private:
+		virtual void		drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
+		virtual void		snapshotCurrent(RenderSnapshot& snapshot, sf::RenderStates states) const;
+		void				loadChunk(std::size_t index);
+		void				readRow(std::vector<unsigned int>& tiles);
+		void				appendTile(sf::VertexArray& vertices, float x, float y, unsigned int tile) const;
+		float				getChunkBottom(std::size_t index) const;
+	private:
+		const sf::Texture&	mTileset;
+		std::ifstream		mFile;
+		sf::FloatRect		mBounds;
+		float				mTileSize;
+		std::size_t			mChunkRows;
+		std::size_t			mColumns;
+		std::size_t			mNextChunk;
+		std::deque<Chunk>	mChunks;
+};
+
+#endif // BOOK_TILEMAPNODE_HPP
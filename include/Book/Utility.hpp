@@ -3,12 +3,14 @@
 
 #include <SFML/Window/Keyboard.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
 #include <sstream>
 
 namespace sf
 {
 	class Sprite;
 	class Text;
+	class Font;
 }
 
 class Animation;
@@ -19,11 +21,12 @@ std::string		toString(sf::Keyboard::Key key);
 void			centerOrigin(sf::Sprite& sprite);
 void			centerOrigin(sf::Text& text);
 void			centerOrigin(Animation& animation);
+void			preloadGlyphs(const sf::Font& font, unsigned int characterSize);
 float			toDegree(float radian);
 float			toRadian(float degree);
-int				randomInt(int exclusiveMax);
 float			length(sf::Vector2f vector);
 sf::Vector2f	unitVector(sf::Vector2f vector);
+bool			sweptIntersects(const sf::FloatRect& moving, sf::Vector2f displacement, const sf::FloatRect& target);
 
 #include <Book/Utility.inl>
 #endif // BOOK_UTILITY_HPP
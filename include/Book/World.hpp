@@ -9,7 +9,14 @@
 #include <Book/CommandQueue.hpp>
 #include <Book/Command.hpp>
 #include <Book/BloomEffect.hpp>
+#include <Book/CpuBloomEffect.hpp>
 #include <Book/SoundPlayer.hpp>
+#include <Book/LevelStream.hpp>
+#include <Book/EntityStore.hpp>
+#include <Book/CollisionDispatcher.hpp>
+#include <Book/CollisionMaskAtlas.hpp>
+#include <Book/ParticleRegistry.hpp>
+#include <Book/RandomGenerator.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/Graphics/View.hpp>
 #include <SFML/Graphics/Texture.hpp>
@@ -21,27 +28,43 @@ namespace sf
 	class RenderTarget;
 }
 
+class JobSystem;
+class GraphicsSettings;
+class RenderTargetPool;
+class TileMapNode;
+class BulletSystem;
+class ParticleNode;
+class RenderSnapshot;
+
 class World : private sf::NonCopyable
 {
 	public:
-											World(sf::RenderTarget& outputTarget, FontHolder& fonts, SoundPlayer& sounds);
+											World(sf::RenderTarget& outputTarget, FontHolder& fonts, SoundPlayer& sounds, JobSystem& jobs, GraphicsSettings& graphics,
+												RenderTargetPool& renderTargets, sf::Uint64 seed);
 		void								update(sf::Time dt);
-		void								draw();
+		void								draw(float interpolation);
+		void								snapshot(RenderSnapshot& snapshot, float interpolation) const;
 		CommandQueue&						getCommandQueue();
 		bool 								hasAlivePlayer() const;
 		bool 								hasPlayerReachedEnd() const;
+		const CollisionStatistics&			getCollisionStatistics() const;
+		sf::Uint64							getSeed() const;
 	private:
 		void								loadTextures();
+		void								buildCollisionMasks();
 		void								adaptPlayerPosition();
 		void								adaptPlayerVelocity();
+		void								registerCollisionResponses();
 		void								handleCollisions();
+		void								collideBullets(Category::Type targets, Projectile::Type bulletType);
 		void								updateSounds();
 		void								buildScene();
-		void								addEnemies();
-		void								addEnemy(Aircraft::Type type, float relX, float relY);
 		void								spawnEnemies();
+		void								applyLevelEvent(const LevelEvent& event);
+		void								spawnEnemy(Aircraft::Type type, float x, float y);
 		void								destroyEntitiesOutsideView();
 		void								guideMissiles();
+		void								updateEntities(sf::Time dt);
 		sf::FloatRect						getViewBounds() const;
 		sf::FloatRect						getBattlefieldBounds() const;
 	private:
@@ -52,35 +75,40 @@ class World : private sf::NonCopyable
 			UpperAir,
 			LayerCount
 		};
-		struct SpawnPoint
-		{
-			SpawnPoint(Aircraft::Type type, float x, float y)
-			: type(type)
-			, x(x)
-			, y(y)
-			{
-			}
-			Aircraft::Type type;
-			float x;
-			float y;
-		};
 	private:
 		sf::RenderTarget&					mTarget;
-		sf::RenderTexture					mSceneTexture;
+		RenderTargetPool&					mRenderTargets;
 		sf::View							mWorldView;
+		sf::Vector2f						mPreviousViewCenter;
 		TextureHolder						mTextures;
+		CollisionMaskAtlas					mMaskAtlas;
 		FontHolder&							mFonts;
 		SoundPlayer&						mSounds;
+		JobSystem&							mJobs;
+		EntityStore							mEntities;
+		CollisionDispatcher					mCollisions;
+		std::vector<EntityStore::Contact>	mContacts;
+		CollisionStatistics					mCollisionStatistics;
 		SceneNode							mSceneGraph;
 		std::array<SceneNode*, LayerCount>	mSceneLayers;
 		CommandQueue						mCommandQueue;
+		LevelStream							mLevel;
 		sf::FloatRect						mWorldBounds;
 		sf::Vector2f						mSpawnPosition;
 		float								mScrollSpeed;
 		Aircraft*							mPlayerAircraft;
-		std::vector<SpawnPoint>				mEnemySpawnPoints;
+		TileMapNode*						mBackground;
+		BulletSystem*						mBullets;
 		std::vector<Aircraft*>				mActiveEnemies;
+		std::vector<Aircraft*>				mCollidingAircraft;
+		std::vector<sf::FloatRect>			mCollisionRects;
+		std::vector<PlacedMask>				mCollisionMasks;
+		std::vector<int>					mCollisionDamages;
+		ParticleRegistry					mParticles;
+		RandomGenerator						mRandom;
 		BloomEffect							mBloomEffect;
+		CpuBloomEffect						mCpuBloomEffect;
+		GraphicsSettings&					mGraphics;
 };
 
 #endif // BOOK_WORLD_HPP
@@ -2,9 +2,12 @@
 #include <Book/DataTables.hpp>
 #include <Book/Utility.hpp>
 #include <Book/Pickup.hpp>
+#include <Book/BulletSystem.hpp>
+#include <Book/RandomGenerator.hpp>
 #include <Book/CommandQueue.hpp>
 #include <Book/SoundNode.hpp>
 #include <Book/ResourceHolder.hpp>
+#include <Book/RenderSnapshot.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/RenderStates.hpp>
 #include <cmath>
@@ -16,8 +19,9 @@ namespace
 	const std::vector<AircraftData> Table = initializeAircraftData();
 }
 
-Aircraft::Aircraft(Type type, const TextureHolder& textures, const FontHolder& fonts)
-: Entity(Table[type].hitpoints)
+Aircraft::Aircraft(Type type, const TextureHolder& textures, const FontHolder& fonts, EntityStore& entities,
+	const ParticleRegistry& particles, RandomGenerator& random)
+: Entity(entities, Table[type].hitpoints)
 , mType(type)
 , mSprite(textures.get(Table[type].texture), Table[type].textureRect)
 , mExplosion(textures.get(Textures::Explosion))
@@ -37,22 +41,23 @@ Aircraft::Aircraft(Type type, const TextureHolder& textures, const FontHolder& f
 , mDirectionIndex(0)
 , mHealthDisplay(nullptr)
 , mMissileDisplay(nullptr)
+, mRandom(random)
 {
 	mExplosion.setFrameSize(sf::Vector2i(256, 256));
 	mExplosion.setNumFrames(16);
 	mExplosion.setDuration(sf::seconds(1));
 	centerOrigin(mSprite);
 	centerOrigin(mExplosion);
-	mFireCommand.category = Category::SceneAirLayer;
-	mFireCommand.action   = [this, &textures] (SceneNode& node, sf::Time)
+	mFireCommand.category = Category::BulletSystem;
+	mFireCommand.action   = derivedAction<BulletSystem>([this] (BulletSystem& bullets, sf::Time)
 	{
-		createBullets(node, textures);
-	};
+		createBullets(bullets);
+	});
 
 	mMissileCommand.category = Category::SceneAirLayer;
-	mMissileCommand.action   = [this, &textures] (SceneNode& node, sf::Time)
+	mMissileCommand.action   = [this, &textures, &particles] (SceneNode& node, sf::Time)
 	{
-		createProjectile(node, Projectile::Missile, 0.f, 0.5f, textures);
+		createProjectile(node, Projectile::Missile, 0.f, 0.5f, textures, particles);
 	};
 
 	mDropPickupCommand.category = Category::SceneAirLayer;
@@ -81,6 +86,14 @@ void Aircraft::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) co
 		target.draw(mSprite, states);
 }
 
+void Aircraft::snapshotCurrent(RenderSnapshot& snapshot, sf::RenderStates states) const
+{
+	if (isDestroyed() && mShowExplosion)
+		snapshot.addToScene(mExplosion, states);
+	else
+		snapshot.addToScene(mSprite, states);
+}
+
 void Aircraft::updateCurrent(sf::Time dt, CommandQueue& commands)
 {
 	// ϴݼ
@@ -94,7 +107,7 @@ void Aircraft::updateCurrent(sf::Time dt, CommandQueue& commands)
 		// űըЧ
 		if (!mPlayedExplosionSound)
 		{
-			SoundEffect::ID soundEffect = (randomInt(2) == 0) ? SoundEffect::Explosion1 : SoundEffect::Explosion2;
+			SoundEffect::ID soundEffect = (mRandom.nextInt(2) == 0) ? SoundEffect::Explosion1 : SoundEffect::Explosion2;
 			playLocalSound(commands, soundEffect);
 			mPlayedExplosionSound = true;
 		}
@@ -102,9 +115,14 @@ void Aircraft::updateCurrent(sf::Time dt, CommandQueue& commands)
 	}
 	// ǷΪӵߵ
 	checkProjectileLaunch(dt, commands);
+}
+
+void Aircraft::steer(sf::Time dt)
+{
+	if (isDestroyed())
+		return;
 	// ϴлƶ
 	updateMovementPattern(dt);
-	Entity::updateCurrent(dt, commands);
 }
 
 unsigned int Aircraft::getCategory() const
@@ -120,6 +138,16 @@ sf::FloatRect Aircraft::getBoundingRect() const
 	return getWorldTransform().transformRect(mSprite.getGlobalBounds());
 }
 
+sf::FloatRect Aircraft::getHitBox() const
+{
+	return Table[mType].hitBox;
+}
+
+sf::IntRect Aircraft::getTextureRect() const
+{
+	return mSprite.getTextureRect();
+}
+
 bool Aircraft::isMarkedForRemoval() const
 {
 	return isDestroyed() && (mExplosion.isFinished() || !mShowExplosion);
@@ -216,7 +244,7 @@ void Aircraft::updateMovementPattern(sf::Time dt)
 
 void Aircraft::checkPickupDrop(CommandQueue& commands)
 {
-	if (!isAllied() && randomInt(3) == 0 && !mSpawnedPickup)
+	if (!isAllied() && mRandom.nextInt(3) == 0 && !mSpawnedPickup)
 		commands.push(mDropPickupCommand);
 	mSpawnedPickup = true;
 }
@@ -251,30 +279,39 @@ void Aircraft::checkProjectileLaunch(sf::Time dt, CommandQueue& commands)
 	}
 }
 
-void Aircraft::createBullets(SceneNode& node, const TextureHolder& textures) const
+void Aircraft::createBullets(BulletSystem& bullets) const
 {
 	Projectile::Type type = isAllied() ? Projectile::AlliedBullet : Projectile::EnemyBullet;
 	switch (mSpreadLevel)
 	{
 		case 1:
-			createProjectile(node, type, 0.0f, 0.5f, textures);
+			createBullet(bullets, type, 0.0f, 0.5f);
 			break;
 		case 2:
-			createProjectile(node, type, -0.33f, 0.33f, textures);
-			createProjectile(node, type, +0.33f, 0.33f, textures);
+			createBullet(bullets, type, -0.33f, 0.33f);
+			createBullet(bullets, type, +0.33f, 0.33f);
 			break;
 		case 3:
-			createProjectile(node, type, -0.5f, 0.33f, textures);
-			createProjectile(node, type,  0.0f, 0.5f, textures);
-			createProjectile(node, type, +0.5f, 0.33f, textures);
+			createBullet(bullets, type, -0.5f, 0.33f);
+			createBullet(bullets, type,  0.0f, 0.5f);
+			createBullet(bullets, type, +0.5f, 0.33f);
 			break;
 	}
 }
 
-void Aircraft::createProjectile(SceneNode& node, Projectile::Type type, float xOffset, float yOffset, const TextureHolder& textures) const
+void Aircraft::createBullet(BulletSystem& bullets, Projectile::Type type, float xOffset, float yOffset) const
+{
+	// ӵӵϵͳͳһ
+	sf::Vector2f offset(xOffset * mSprite.getGlobalBounds().width, yOffset * mSprite.getGlobalBounds().height);
+	float sign = isAllied() ? -1.f : +1.f;
+	bullets.addBullet(type, getWorldPosition() + offset * sign, sf::Vector2f(0.f, sign));
+}
+
+void Aircraft::createProjectile(SceneNode& node, Projectile::Type type, float xOffset, float yOffset, const TextureHolder& textures,
+	const ParticleRegistry& particles) const
 {
 	//ӵƶ
-	std::unique_ptr<Projectile> projectile(new Projectile(type, textures));
+	std::unique_ptr<Projectile> projectile(new Projectile(type, textures, getStore(), particles));
 	sf::Vector2f offset(xOffset * mSprite.getGlobalBounds().width, yOffset * mSprite.getGlobalBounds().height);
 	sf::Vector2f velocity(0, projectile->getMaxSpeed());
 	float sign = isAllied() ? -1.f : +1.f;
@@ -285,8 +322,8 @@ void Aircraft::createProjectile(SceneNode& node, Projectile::Type type, float xO
 
 void Aircraft::createPickup(SceneNode& node, const TextureHolder& textures) const
 {
-	auto type = static_cast<Pickup::Type>(randomInt(Pickup::TypeCount));
-	std::unique_ptr<Pickup> pickup(new Pickup(type, textures));
+	auto type = static_cast<Pickup::Type>(mRandom.nextInt(Pickup::TypeCount));
+	std::unique_ptr<Pickup> pickup(new Pickup(type, textures, getStore()));
 	pickup->setPosition(getWorldPosition());
 	pickup->setVelocity(0.f, 1.f);
 	node.attachChild(std::move(pickup));
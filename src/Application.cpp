@@ -8,34 +8,64 @@
 #include <Book/PauseState.hpp>
 #include <Book/SettingsState.hpp>
 #include <Book/GameOverState.hpp>
+#include <SFML/OpenGL.hpp>
 
 
 const sf::Time Application::TimePerFrame = sf::seconds(1.f/60.f);
+// 渲染最多占一帧的四分之三，其余留给输入和更新
+const float Application::RenderBudgetRatio = 0.75f;
+const bool Application::IdleModeEnabled = true;
 
-Application::Application()
+Application::Application(sf::Uint64 seed, std::size_t maxUpdatesPerFrame)
 : mWindow(sf::VideoMode(1024, 768), "Plane", sf::Style::Close)
 , mTextures()
 , mFonts()
 , mPlayer()
 , mMusic()
 , mSounds()
-, mStateStack(State::Context(mWindow, mTextures, mFonts, mPlayer, mMusic, mSounds))
+, mJobs()
+, mGraphics()
+, mRenderTargets()
+, mCollisionStatistics()
+, mStateStack(State::Context(mWindow, mTextures, mFonts, mPlayer, mMusic, mSounds, mJobs, mGraphics, mRenderTargets, mCollisionStatistics, seed))
 , mStatisticsText()
 , mStatisticsUpdateTime()
 , mStatisticsNumFrames(0)
+, mBloomTimings()
+, mBloomAverages()
+, mLastTimedFrame(0)
+, mRenderThread()
+, mFrameMonitor(TimePerFrame)
+, mFrameLimiter(0)
+, mFramerateLimit(0)
+, mVerticalSync(false)
+, mResolutionScaler(TimePerFrame * RenderBudgetRatio)
+, mLastScaledFrame(0)
 {
 	mWindow.setKeyRepeatEnabled(false);
-	mWindow.setVerticalSyncEnabled(true);
+	// 0 表示使用设置中的默认追赶步数
+	if (maxUpdatesPerFrame > 0)
+		mGraphics.setMaxUpdatesPerFrame(maxUpdatesPerFrame);
 	mFonts.load(Fonts::Main, 	"Media/segoepr.ttf");
+	// 预先载入界面各字号的字形，之后修改文字不会再改动字体纹理，渲染线程读取纹理时不会与主线程冲突
+	const unsigned int textSizes[] = {10, 16, 20, 30, 70};
+	for (std::size_t i = 0; i < sizeof(textSizes) / sizeof(textSizes[0]); ++i)
+		preloadGlyphs(mFonts.get(Fonts::Main), textSizes[i]);
 	mTextures.load(Textures::TitleScreen,	"Media/Textures/TitleScreen.png");
 	mTextures.load(Textures::Buttons,		"Media/Textures/Buttons.png");
 	//显示FPS
-	//mStatisticsText.setFont(mFonts.get(Fonts::Main));
-	//mStatisticsText.setPosition(5.f, 5.f);
-	//mStatisticsText.setCharacterSize(10u);
+	mStatisticsText.setFont(mFonts.get(Fonts::Main));
+	mStatisticsText.setPosition(5.f, 5.f);
+	mStatisticsText.setCharacterSize(10u);
 	registerStates();
 	mStateStack.pushState(States::Title);
 	mMusic.setVolume(25.f);
+	// 状态切换前让渲染线程丢弃引用旧资源的快照
+	mStateStack.setChangeCallback([this] ()
+	{
+		if (mRenderThread)
+			mRenderThread->flush();
+	});
 }
 
 void Application::run()
@@ -46,18 +76,41 @@ void Application::run()
 	{
 		sf::Time dt = clock.restart();
 		timeSinceLastUpdate += dt;
-		while (timeSinceLastUpdate > TimePerFrame)
+		mFrameMonitor.beginFrame();
+		updateRenderThread();
+		updateFramePacing();
+		// 每帧最多追赶设置中的步数，避免卡顿后越追越慢
+		std::size_t maxUpdates = mGraphics.getMaxUpdatesPerFrame();
+		std::size_t updateSteps = 0;
+		while (timeSinceLastUpdate > TimePerFrame && updateSteps < maxUpdates)
 		{
 			timeSinceLastUpdate -= TimePerFrame;
+			mFrameMonitor.beginPhase(FrameBudgetMonitor::Input);
 			processInput();
+			mFrameMonitor.beginPhase(FrameBudgetMonitor::Update);
 			update(TimePerFrame);
+			mFrameMonitor.endPhase();
+			mFrameMonitor.addUpdateStep();
+			++updateSteps;
 			// 检查循环成立条件
 			if (mStateStack.isEmpty())
-				mWindow.close();
+				closeWindow();
+		}
+		// 追赶不上时丢弃积压的时间，游戏暂时变慢而不是卡死
+		if (timeSinceLastUpdate > TimePerFrame)
+		{
+			mFrameMonitor.addDroppedTime(timeSinceLastUpdate - TimePerFrame);
+			timeSinceLastUpdate = TimePerFrame;
 		}
 		updateStatistics(dt);
-		render();
+		render(timeSinceLastUpdate.asSeconds() / TimePerFrame.asSeconds());
+		mFrameMonitor.endFrame();
+		updateResolutionScale();
+		// 关闭垂直同步时休眠到下一帧；开启时由 display 等待，限制器不工作
+		mFrameLimiter.wait();
 	}
+	if (!mFrameMonitor.getOverruns().empty())
+		mFrameMonitor.writeReport("FrameBudget.log");
 }
 
 void Application::processInput()
@@ -67,7 +120,10 @@ void Application::processInput()
 	{
 		mStateStack.handleEvent(event);
 		if (event.type == sf::Event::Closed)
-			mWindow.close();
+			closeWindow();
+		// 窗口内容可能被系统丢弃，需要重新绘制
+		else if (event.type == sf::Event::Resized || event.type == sf::Event::GainedFocus)
+			mStateStack.requestRedraw();
 	}
 }
 
@@ -76,27 +132,195 @@ void Application::update(sf::Time dt)
 	mStateStack.update(dt);
 }
 
-void Application::render()
+void Application::render(float interpolation)
 {
+	// 空闲模式：画面没有变化时跳过绘制，窗口保留上一帧
+	if (IdleModeEnabled && !mStateStack.needsRedraw())
+		return;
+	mFrameMonitor.beginPhase(FrameBudgetMonitor::Render);
+	if (mRenderThread)
+	{
+		mRenderThread->setGraphicsSettings(mGraphics);
+		RenderSnapshot& snapshot = mRenderThread->getBackSnapshot();
+		mStateStack.snapshot(snapshot, interpolation);
+		if (mGraphics.isStatisticsVisible())
+			snapshot.addToOverlay(mStatisticsText);
+		mRenderThread->publish();
+		return;
+	}
 	mWindow.clear();
-	mStateStack.draw();
+	mStateStack.draw(interpolation);
 	mWindow.setView(mWindow.getDefaultView());
-//	mWindow.draw(mStatisticsText);
+	if (mGraphics.isStatisticsVisible())
+		mWindow.draw(mStatisticsText);
+	// 动态分辨率需要包含GPU时间的渲染耗时，等待GPU完成后再进入Present阶段
+	if (mGraphics.isDynamicResolutionEnabled())
+		glFinish();
+	mFrameMonitor.beginPhase(FrameBudgetMonitor::Present);
 	mWindow.display();
+	mRenderTargets.endFrame();
+}
+
+void Application::closeWindow()
+{
+	// 先停止渲染线程，再关闭窗口
+	if (mRenderThread)
+		mRenderThread->stop();
+	mWindow.close();
+}
+
+void Application::updateRenderThread()
+{
+	// 模拟与渲染分离：主线程只生成快照，渲染线程绘制最新的一份；设置改变时在帧之间切换
+	bool enabled = mGraphics.isRenderThreadEnabled();
+	if (enabled && !mRenderThread)
+	{
+		mRenderThread.reset(new RenderThread(mWindow, mJobs));
+	}
+	else if (!enabled && mRenderThread)
+	{
+		mRenderThread->stop();
+		mRenderThread.reset();
+		// 渲染线程可能改过垂直同步，重新在主线程的上下文中设置
+		mVerticalSync = mGraphics.isVerticalSyncEnabled();
+		mWindow.setVerticalSyncEnabled(mVerticalSync);
+		mStateStack.requestRedraw();
+	}
+}
+
+void Application::updateFramePacing()
+{
+	// 垂直同步和帧率限制只启用其一，避免同一帧被限制两次
+	// 使用渲染线程时主循环不会被垂直同步阻塞，按帧率上限生成快照，避免空转
+	bool verticalSync = mGraphics.isVerticalSyncEnabled();
+	unsigned int framerate = (verticalSync && !mRenderThread) ? 0 : mGraphics.getFramerateLimit();
+	if (framerate != mFramerateLimit)
+	{
+		mFrameLimiter.setFramerate(framerate);
+		mFramerateLimit = framerate;
+		// 渲染预算跟随帧率上限；垂直同步和不限制时按更新频率估计
+		sf::Time frameTime = (framerate > 0) ? sf::seconds(1.f / framerate) : TimePerFrame;
+		mResolutionScaler.setTargetFrameTime(frameTime * RenderBudgetRatio);
+	}
+	// 使用渲染线程时窗口上下文属于渲染线程，由它设置垂直同步
+	if (!mRenderThread && verticalSync != mVerticalSync)
+	{
+		mWindow.setVerticalSyncEnabled(verticalSync);
+		mVerticalSync = verticalSync;
+	}
 }
 
 void Application::updateStatistics(sf::Time dt)
 {
 	mStatisticsUpdateTime += dt;
 	mStatisticsNumFrames += 1;
+	// 附带最近一帧泛光各遍的数量和耗时；使用渲染线程时读取它自己的统计
+	RenderThread::Statistics statistics;
+	if (mRenderThread)
+	{
+		statistics = mRenderThread->getStatistics();
+	}
+	else
+	{
+		statistics.bloom = mGraphics.getBloomStatistics();
+		statistics.renderTime = mFrameMonitor.getLastFrame().phases[FrameBudgetMonitor::Render];
+		statistics.frameCount = mFrameMonitor.getLastFrame().frame;
+		statistics.targetCount = mRenderTargets.getTargetCount();
+		statistics.targetMemory = mRenderTargets.getMemoryUsage();
+	}
+	const BloomEffect::Statistics& bloom = statistics.bloom;
+	// 分别累计GPU和CPU泛光的耗时，切换实现后可以直接对比；跳过没有绘制的空闲帧和已经计过的帧
+	// GPU各遍只计命令提交的时间，渲染时间在开启动态分辨率时才包含GPU执行
+	if (bloom.quality != BloomEffect::Off && statistics.renderTime != sf::Time::Zero
+		&& statistics.frameCount != mLastTimedFrame)
+	{
+		mLastTimedFrame = statistics.frameCount;
+		BloomTiming& timing = mBloomTimings[mGraphics.usesCpuBloom() ? 1 : 0];
+		for (std::size_t type = 0; type < BloomEffect::PassTypeCount; ++type)
+			timing.bloomTime += bloom.passTimes[type];
+		timing.renderTime += statistics.renderTime;
+		timing.frames += 1;
+	}
 	if (mStatisticsUpdateTime >= sf::seconds(1.0f))
 	{
-		mStatisticsText.setString("FPS: " + toString(mStatisticsNumFrames));
+		std::string text = "FPS: " + toString(mStatisticsNumFrames) + "\n";
+		text += "Bloom: " + std::string(BloomEffect::getQualityName(bloom.quality)) + ", " + toString(bloom.passCount) + " passes";
+		for (std::size_t type = 0; type < BloomEffect::PassTypeCount; ++type)
+		{
+			if (bloom.passCounts[type] == 0)
+				continue;
+			text += "\n" + std::string(BloomEffect::getPassName(static_cast<BloomEffect::PassType>(type)))
+				+ " x" + toString(bloom.passCounts[type])
+				+ ": " + toString(bloom.passTimes[type].asMicroseconds()) + "us";
+		}
+		const char* deviceNames[2] = { "GPU", "CPU" };
+		for (std::size_t i = 0; i < mBloomTimings.size(); ++i)
+		{
+			BloomTiming& timing = mBloomTimings[i];
+			if (timing.frames > 0)
+			{
+				sf::Int64 frames = static_cast<sf::Int64>(timing.frames);
+				timing.bloomTime = timing.bloomTime / frames;
+				timing.renderTime = timing.renderTime / frames;
+				mBloomAverages[i] = timing;
+				timing = BloomTiming();
+			}
+			text += "\n" + std::string(deviceNames[i]) + " bloom: ";
+			if (mBloomAverages[i].frames == 0)
+				text += "-";
+			else
+				text += toString(mBloomAverages[i].bloomTime.asMicroseconds()) + "us / render "
+					+ toString(mBloomAverages[i].renderTime.asMicroseconds()) + "us";
+		}
+		const CollisionStatistics& collisions = mCollisionStatistics;
+		text += "\nCollisions: " + toString(collisions.tests) + " tests, " + toString(collisions.candidates) + " candidates, "
+			+ toString(collisions.maskTests) + " masks, " + toString(collisions.contacts) + " contacts, "
+			+ toString(collisions.time.asMicroseconds()) + "us";
+		text += "\nBullets: " + toString(collisions.bulletTests) + " tests, " + toString(collisions.bulletMaskTests) + " masks, "
+			+ toString(collisions.bulletHits) + " hits";
+		text += "\nScene scale: " + toString(mGraphics.getResolutionScale());
+		text += "\nTargets: " + toString(statistics.targetCount)
+			+ " (" + toString(statistics.targetMemory / 1024) + " KB)";
+		mStatisticsText.setString(text);
+		// 显示统计时每秒刷新一次画面，空闲模式下也能看到新的数字
+		if (mGraphics.isStatisticsVisible())
+			mStateStack.requestRedraw();
 		mStatisticsUpdateTime -= sf::seconds(1.0f);
 		mStatisticsNumFrames = 0;
 	}
 }
 
+void Application::updateResolutionScale()
+{
+	// 根据实测的渲染时间调整场景纹理的分辨率，关闭时恢复原始分辨率
+	// 帧间隔包含限制器休眠和垂直同步等待，正常的帧总是接近一帧时间，不能用来判断余量
+	if (!mGraphics.isDynamicResolutionEnabled())
+	{
+		mResolutionScaler.reset();
+		return;
+	}
+	sf::Time renderTime;
+	std::size_t frame;
+	if (mRenderThread)
+	{
+		RenderThread::Statistics statistics = mRenderThread->getStatistics();
+		renderTime = statistics.renderTime;
+		frame = statistics.frameCount;
+	}
+	else
+	{
+		const FrameBudgetMonitor::Record& record = mFrameMonitor.getLastFrame();
+		renderTime = record.phases[FrameBudgetMonitor::Render];
+		frame = record.frame;
+	}
+	// 空闲模式下跳过绘制的帧没有渲染时间；渲染线程比主循环慢时同一帧会被读到多次，每帧只计一次
+	if (renderTime == sf::Time::Zero || frame == mLastScaledFrame)
+		return;
+	mLastScaledFrame = frame;
+	mResolutionScaler.addFrame(renderTime);
+	mGraphics.setResolutionScale(mResolutionScaler.getScale());
+}
+
 void Application::registerStates()
 {
 	mStateStack.registerState<TitleState>(States::Title);
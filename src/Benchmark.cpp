@@ -0,0 +1,302 @@
+#include <Book/BloomEffect.hpp>
+#include <Book/CpuBloomEffect.hpp>
+#include <Book/RenderTargetPool.hpp>
+#include <Book/JobSystem.hpp>
+#include <Book/BulletSystem.hpp>
+#include <Book/CollisionMaskAtlas.hpp>
+#include <Book/DataTables.hpp>
+#include <Book/Aircraft.hpp>
+#include <Book/RandomGenerator.hpp>
+#include <Book/ResourceHolder.hpp>
+#include <Book/Entity.hpp>
+#include <Book/EntityStore.hpp>
+#include <Book/CollisionDispatcher.hpp>
+#include <Book/Utility.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/OpenGL.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// 性能测试入口：与游戏共用 src 下的源文件，需要在游戏的工作目录中运行（着色器从 Media 读取）
+// 用法：09_Audio_Benchmark [模式] [帧数]，模式为 jobs、collisions、bloom、bullets 或 all
+// 对比 Mesa 软件渲染器上的着色器泛光时，先设置 LIBGL_ALWAYS_SOFTWARE=1
+namespace
+{
+	const unsigned int SceneWidth = 1024;
+	const unsigned int SceneHeight = 768;
+	const std::size_t BulletCount = 10000;
+	const std::size_t BulletTargetCount = 64;
+	const std::size_t JobElementCount = 1 << 20;
+	const std::size_t JobGrainSize = 4096;
+	const std::size_t CollisionEntityCount = 5000;
+	const float CollisionAreaHeight = 4096.f;
+
+	// 只有碰撞框和类别的实体，宽阶段测试不需要纹理
+	class BenchmarkEntity : public Entity
+	{
+		public:
+			BenchmarkEntity(EntityStore& store, Category::Type category)
+			: Entity(store, 1)
+			, mCategory(category)
+			{
+			}
+
+			virtual unsigned int getCategory() const
+			{
+				return mCategory;
+			}
+
+			virtual sf::FloatRect getHitBox() const
+			{
+				return sf::FloatRect(-16.f, -16.f, 32.f, 32.f);
+			}
+
+			virtual sf::IntRect getTextureRect() const
+			{
+				return sf::IntRect();
+			}
+
+		private:
+			Category::Type mCategory;
+	};
+
+	void benchmarkJobs(std::size_t frames)
+	{
+		// 同一个计算密集的 parallelFor 在 1 到硬件线程数之间运行，报告相对单线程的加速比
+		std::vector<float> values(JobElementCount, 1.f);
+		std::size_t maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		sf::Time baseline;
+		std::cout << "Jobs " << JobElementCount << " elements, grain " << JobGrainSize << ", " << frames << " frames" << std::endl;
+		std::cout << "Threads\tus\tSpeedup" << std::endl;
+		for (std::size_t threads = 1; threads <= maxThreads; ++threads)
+		{
+			JobSystem jobs(threads);
+			sf::Clock clock;
+			for (std::size_t frame = 0; frame < frames; ++frame)
+			{
+				jobs.parallelFor(values.size(), JobGrainSize, [&values] (std::size_t begin, std::size_t end)
+				{
+					for (std::size_t i = begin; i < end; ++i)
+						values[i] = std::sqrt(values[i] * values[i] + 1.f) * 0.5f;
+				});
+			}
+			sf::Time time = clock.getElapsedTime() / static_cast<sf::Int64>(frames);
+			if (threads == 1)
+				baseline = time;
+			std::cout << threads << "\t" << time.asMicroseconds() << "\t" << baseline.asSeconds() / time.asSeconds() << std::endl;
+		}
+	}
+
+	void benchmarkCollisions(std::size_t frames)
+	{
+		// 5000 个实体分布在与关卡相近的竖长区域，三分之一是敌机，其余是友方导弹；
+		// 对比 EntityStore 的排序扫描与同一批包围盒上的逐对扫掠测试
+		EntityStore store;
+		SceneNode root;
+		RandomGenerator random(1);
+		for (std::size_t i = 0; i < CollisionEntityCount; ++i)
+		{
+			Category::Type category = (i % 3 == 0) ? Category::EnemyAircraft : Category::AlliedProjectile;
+			std::unique_ptr<BenchmarkEntity> entity(new BenchmarkEntity(store, category));
+			entity->setPosition(static_cast<float>(random.nextInt(SceneWidth)), static_cast<float>(random.nextInt(static_cast<int>(CollisionAreaHeight))));
+			entity->setVelocity(0.f, (category == Category::EnemyAircraft) ? 80.f : -400.f);
+			root.attachChild(std::move(entity));
+		}
+		CollisionDispatcher collisions;
+		collisions.addResponse<SceneNode, SceneNode>(Category::EnemyAircraft, Category::AlliedProjectile, [] (SceneNode&, SceneNode&) {});
+		CollisionMaskAtlas masks;
+		JobSystem jobs;
+		std::vector<EntityStore::Contact> contacts;
+		CollisionStatistics statistics = CollisionStatistics();
+		sf::Time sweepTime;
+		std::size_t sweepTests = 0;
+		for (std::size_t frame = 0; frame < frames; ++frame)
+		{
+			store.integrate(sf::seconds(1.f / 60.f), jobs);
+			store.updateColliders(masks);
+			contacts.clear();
+			sf::Clock clock;
+			store.checkCollisions(collisions, contacts, statistics);
+			sweepTime += clock.getElapsedTime();
+			sweepTests += statistics.tests;
+		}
+		// 逐对参考：同样的包围盒、位移和类别过滤，只是不排序
+		std::vector<sf::FloatRect> bounds;
+		std::vector<sf::Vector2f> displacements;
+		std::vector<unsigned int> categories;
+		for (std::size_t i = 0; i < CollisionEntityCount; ++i)
+		{
+			const BenchmarkEntity& entity = static_cast<const BenchmarkEntity&>(*store.getEntity(i));
+			bounds.push_back(entity.getHitBounds());
+			displacements.push_back(entity.getVelocity() / 60.f);
+			categories.push_back(entity.getCategory());
+		}
+		sf::Clock clock;
+		std::size_t pairTests = 0;
+		std::size_t pairHits = 0;
+		for (std::size_t frame = 0; frame < frames; ++frame)
+		{
+			for (std::size_t i = 0; i < bounds.size(); ++i)
+			{
+				unsigned int mask = collisions.getCollisionMask(categories[i]);
+				for (std::size_t j = i + 1; j < bounds.size(); ++j)
+				{
+					if (!(mask & categories[j]))
+						continue;
+					++pairTests;
+					if (sweptIntersects(bounds[i], displacements[i] - displacements[j], bounds[j]))
+						++pairHits;
+				}
+			}
+		}
+		sf::Time pairTime = clock.getElapsedTime();
+		sf::Int64 count = static_cast<sf::Int64>(frames);
+		std::cout << "Collisions " << CollisionEntityCount << " entities, " << frames << " frames (" << pairHits / frames << " swept hits)" << std::endl;
+		std::cout << "Sort and sweep: " << (sweepTime / count).asMicroseconds() << "us, " << sweepTests / frames << " tests" << std::endl;
+		std::cout << "All pairs:      " << (pairTime / count).asMicroseconds() << "us, " << pairTests / frames << " tests" << std::endl;
+	}
+
+	void drawTestScene(sf::RenderTexture& scene)
+	{
+		// 暗背景上铺满亮度不同的方块，亮部阈值上下都有像素
+		scene.clear(sf::Color(20, 20, 40));
+		sf::RectangleShape block(sf::Vector2f(24.f, 24.f));
+		for (unsigned int y = 0; y < SceneHeight / 32; ++y)
+		{
+			for (unsigned int x = 0; x < SceneWidth / 32; ++x)
+			{
+				sf::Uint8 level = static_cast<sf::Uint8>((x * 37 + y * 91) % 256);
+				block.setFillColor(sf::Color(level, static_cast<sf::Uint8>(255 - level), level));
+				block.setPosition(x * 32.f + 4.f, y * 32.f + 4.f);
+				scene.draw(block);
+			}
+		}
+		scene.display();
+	}
+
+	sf::Time measureEffect(PostEffect& effect, const sf::RenderTexture& scene, sf::RenderTexture& output, std::size_t frames)
+	{
+		// 每帧都等待GPU完成，着色器泛光的时间才包含GPU执行而不只是命令提交
+		effect.apply(scene, output);
+		glFinish();
+		sf::Clock clock;
+		for (std::size_t i = 0; i < frames; ++i)
+		{
+			effect.apply(scene, output);
+			glFinish();
+		}
+		return clock.getElapsedTime() / static_cast<sf::Int64>(frames);
+	}
+
+	void benchmarkBloom(std::size_t frames)
+	{
+		sf::RenderTexture scene;
+		sf::RenderTexture output;
+		if (!scene.create(SceneWidth, SceneHeight) || !output.create(SceneWidth, SceneHeight))
+			throw std::runtime_error("Benchmark - Failed to create render textures");
+		drawTestScene(scene);
+		output.setActive(true);
+		std::cout << "Bloom " << SceneWidth << "x" << SceneHeight << ", " << frames << " frames, renderer: "
+			<< reinterpret_cast<const char*>(glGetString(GL_RENDERER)) << std::endl;
+		RenderTargetPool renderTargets;
+		JobSystem jobs;
+		BloomEffect gpuBloom(renderTargets);
+		CpuBloomEffect cpuBloom(jobs);
+		std::cout << "Quality\tGPU us\tCPU us (" << jobs.getThreadCount() << " threads)" << std::endl;
+		for (int quality = BloomEffect::Low; quality < BloomEffect::QualityCount; ++quality)
+		{
+			gpuBloom.setQuality(static_cast<BloomEffect::Quality>(quality));
+			cpuBloom.setQuality(static_cast<BloomEffect::Quality>(quality));
+			sf::Time gpuTime = measureEffect(gpuBloom, scene, output, frames);
+			sf::Time cpuTime = measureEffect(cpuBloom, scene, output, frames);
+			std::cout << BloomEffect::getQualityName(static_cast<BloomEffect::Quality>(quality))
+				<< "\t" << gpuTime.asMicroseconds() << "\t" << cpuTime.asMicroseconds() << std::endl;
+		}
+	}
+
+	void benchmarkBullets(std::size_t frames)
+	{
+		// 一个阵营的子弹对一组敌机做一次批量查询，与逐对检查的组合数对比
+		TextureHolder textures;
+		textures.load(Textures::Entities, "Media/Textures/Entities.png");
+		std::vector<ProjectileData> projectiles = initializeProjectileData();
+		std::vector<AircraftData> aircraft = initializeAircraftData();
+		const AircraftData& raptor = aircraft[Aircraft::Raptor];
+		std::vector<sf::IntRect> rects;
+		rects.push_back(projectiles[Projectile::AlliedBullet].textureRect);
+		rects.push_back(projectiles[Projectile::EnemyBullet].textureRect);
+		rects.push_back(raptor.textureRect);
+		CollisionMaskAtlas masks;
+		masks.build(textures.get(Textures::Entities), rects);
+		RandomGenerator random(1);
+		std::vector<sf::FloatRect> targets;
+		std::vector<PlacedMask> targetMasks;
+		for (std::size_t i = 0; i < BulletTargetCount; ++i)
+		{
+			float x = static_cast<float>(random.nextInt(SceneWidth));
+			float y = static_cast<float>(random.nextInt(SceneHeight));
+			targets.push_back(sf::FloatRect(x + raptor.hitBox.left, y + raptor.hitBox.top, raptor.hitBox.width, raptor.hitBox.height));
+			PlacedMask placed = {masks.find(raptor.textureRect, false),
+				sf::Vector2i(static_cast<int>(x) - raptor.textureRect.width / 2, static_cast<int>(y) - raptor.textureRect.height / 2)};
+			targetMasks.push_back(placed);
+		}
+		JobSystem jobs;
+		sf::FloatRect bounds(0.f, 0.f, static_cast<float>(SceneWidth), static_cast<float>(SceneHeight));
+		std::vector<int> damages;
+		CollisionStatistics statistics = CollisionStatistics();
+		sf::Time time;
+		for (std::size_t frame = 0; frame < frames; ++frame)
+		{
+			// 每帧重新发射同一批子弹，只计批量查询本身的时间
+			BulletSystem bullets(textures, masks);
+			RandomGenerator positions(frame + 1);
+			for (std::size_t i = 0; i < BulletCount; ++i)
+			{
+				sf::Vector2f position(static_cast<float>(positions.nextInt(SceneWidth)), static_cast<float>(positions.nextInt(SceneHeight)));
+				bullets.addBullet(Projectile::AlliedBullet, position, sf::Vector2f(0.f, -1.f));
+			}
+			bullets.updateBullets(sf::seconds(1.f / 60.f), bounds, jobs);
+			sf::Clock clock;
+			bullets.collide(Projectile::AlliedBullet, targets, targetMasks, damages, statistics);
+			time += clock.getElapsedTime();
+		}
+		sf::Int64 count = static_cast<sf::Int64>(frames);
+		std::cout << "Bullets " << BulletCount << " x " << BulletTargetCount << " targets, " << frames << " frames: "
+			<< (time / count).asMicroseconds() << "us per query, "
+			<< statistics.bulletTests / frames << " swept tests of " << BulletCount * BulletTargetCount << " pairs, "
+			<< statistics.bulletMaskTests / frames << " mask tests, " << statistics.bulletHits / frames << " hits" << std::endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		std::string mode = (argc > 1) ? argv[1] : "all";
+		std::size_t frames = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 100;
+		frames = std::max<std::size_t>(frames, 1);
+		if (mode == "jobs" || mode == "all")
+			benchmarkJobs(frames);
+		if (mode == "collisions" || mode == "all")
+			benchmarkCollisions(frames);
+		if (mode == "bloom" || mode == "all")
+			benchmarkBloom(frames);
+		if (mode == "bullets" || mode == "all")
+			benchmarkBullets(frames);
+	}
+	catch (std::exception& error)
+	{
+		std::cout << "\nEXCEPTION: " << error.what() << std::endl;
+	}
+	return 0;
+}
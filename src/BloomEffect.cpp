@@ -1,87 +1,380 @@
 #include <Book/BloomEffect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <string>
 
-BloomEffect::BloomEffect()
+namespace
+{
+	// 亮度提取与第一次降采样合并：对3x3邻域逐个取亮部再求平均，省去全分辨率的中间纹理
+	// 阈值和系数与 Brightness.frag 保持一致
+	const std::string BrightDownSampleShader =
+		"uniform sampler2D source;\n"
+		"uniform vec2 sourceSize;\n"
+		"const float Threshold = 0.7;\n"
+		"const float Factor = 4.0;\n"
+		"vec4 bright(vec2 coords)\n"
+		"{\n"
+		"	vec4 color = texture2D(source, coords);\n"
+		"	float luminance = dot(color.rgb, vec3(0.2126, 0.7152, 0.0722));\n"
+		"	return color * clamp(luminance - Threshold, 0.0, 1.0) * Factor;\n"
+		"}\n"
+		"void main()\n"
+		"{\n"
+		"	vec2 pixelSize = vec2(1.0 / sourceSize.x, 1.0 / sourceSize.y);\n"
+		"	vec2 coords = gl_TexCoord[0].xy;\n"
+		"	vec4 color = vec4(0.0);\n"
+		"	for (int x = -1; x <= 1; ++x)\n"
+		"		for (int y = -1; y <= 1; ++y)\n"
+		"			color += bright(coords + vec2(float(x), float(y)) * pixelSize);\n"
+		"	gl_FragColor = color / 9.0;\n"
+		"}\n";
+
+	// 两级泛光一次叠加到原图上
+	const std::string CompositeShader =
+		"uniform sampler2D source;\n"
+		"uniform sampler2D bloom;\n"
+		"uniform sampler2D bloomLow;\n"
+		"uniform float bloomLowFactor;\n"
+		"void main()\n"
+		"{\n"
+		"	vec2 coords = gl_TexCoord[0].xy;\n"
+		"	gl_FragColor = texture2D(source, coords) + texture2D(bloom, coords)\n"
+		"		+ bloomLowFactor * texture2D(bloomLow, coords);\n"
+		"}\n";
+
+	// 新计算的泛光与上一次的结果按权重混合
+	const std::string TemporalBlendShader =
+		"uniform sampler2D bloom;\n"
+		"uniform sampler2D bloomLow;\n"
+		"uniform float bloomLowFactor;\n"
+		"uniform sampler2D history;\n"
+		"uniform float historyWeight;\n"
+		"void main()\n"
+		"{\n"
+		"	vec2 coords = gl_TexCoord[0].xy;\n"
+		"	vec4 current = texture2D(bloom, coords) + bloomLowFactor * texture2D(bloomLow, coords);\n"
+		"	gl_FragColor = mix(current, texture2D(history, coords), historyWeight);\n"
+		"}\n";
+}
+
+// 各档位：亮度提取是否与降采样合并，第一级纹理的缩小倍数，是否有第二级，每级模糊次数
+const BloomEffect::QualitySettings BloomEffect::QualityTable[BloomEffect::QualityCount] =
+{
+	{ false, 1, false, 0 },	// Off
+	{ false, 4, false, 1 },	// Low
+	{ false, 2, true,  1 },	// Medium
+	{ true,  2, true,  2 },	// High
+};
+
+BloomEffect::Statistics::Statistics()
+: quality(High)
+, passCount(0)
+, passCounts()
+, passTimes()
+{
+	passCounts.fill(0);
+	passTimes.fill(sf::Time::Zero);
+}
+
+BloomEffect::BloomEffect(RenderTargetPool& renderTargets)
 : mShaders()
-, mBrightnessTexture()
+, mRenderTargets(renderTargets)
 , mFirstPassTextures()
 , mSecondPassTextures()
+, mQuality(High)
+, mUpdateInterval(1)
+, mHistoryWeight(0.5f)
+, mHistoryTextures()
+, mHistoryIndex(0)
+, mHistoryValid(false)
+, mFramesSinceUpdate(0)
+, mStatistics()
+, mPassClock()
 {
 	mShaders.load(Shaders::BrightnessPass,   "Media/Shaders/Fullpass.vert", "Media/Shaders/Brightness.frag");
 	mShaders.load(Shaders::DownSamplePass,   "Media/Shaders/Fullpass.vert", "Media/Shaders/DownSample.frag");
 	mShaders.load(Shaders::GaussianBlurPass, "Media/Shaders/Fullpass.vert", "Media/Shaders/GuassianBlur.frag");
-	mShaders.load(Shaders::AddPass,          "Media/Shaders/Fullpass.vert", "Media/Shaders/Add.frag");
+	mShaders.loadFromMemory(Shaders::BrightDownSamplePass, BrightDownSampleShader, sf::Shader::Fragment);
+	mShaders.loadFromMemory(Shaders::CompositePass,        CompositeShader,        sf::Shader::Fragment);
+	mShaders.loadFromMemory(Shaders::TemporalBlendPass,    TemporalBlendShader,    sf::Shader::Fragment);
+}
+
+BloomEffect::~BloomEffect()
+{
+	releaseHistory();
 }
 
 void BloomEffect::apply(const sf::RenderTexture& input, sf::RenderTarget& output)
 {
-	prepareTextures(input.getSize());
-	filterBright(input, mBrightnessTexture);
-	downsample(mBrightnessTexture, mFirstPassTextures[0]);
-	blurMultipass(mFirstPassTextures);
-	downsample(mFirstPassTextures[0], mSecondPassTextures[0]);
-	blurMultipass(mSecondPassTextures);
-	add(mFirstPassTextures[0], mSecondPassTextures[0], mFirstPassTextures[1]);
-	mFirstPassTextures[1].display();
-	add(input, mFirstPassTextures[1], output);
+	mStatistics = Statistics();
+	mStatistics.quality = mQuality;
+	if (mQuality == Off)
+	{
+		releaseHistory();
+		copy(input, output);
+		return;
+	}
+	const QualitySettings& settings = QualityTable[mQuality];
+	if (mUpdateInterval <= 1)
+	{
+		releaseHistory();
+		computeBloom(input, settings);
+		if (settings.secondLevel)
+			composite(input, *mFirstPassTextures[0], *mSecondPassTextures[0], output);
+		else
+			composite(input, *mFirstPassTextures[0], *mFirstPassTextures[0], output, 0.f);
+		releaseTextures();
+		return;
+	}
+	// 时间复用：每隔若干帧才重新计算泛光，其余帧直接使用历史纹理
+	sf::Vector2u size = input.getSize();
+	sf::Vector2u levelSize(size.x / settings.firstLevelDivisor, size.y / settings.firstLevelDivisor);
+	if (!mHistoryTextures[0] || mHistoryTextures[0]->getSize() != levelSize)
+	{
+		releaseHistory();
+		for (std::size_t i = 0; i < mHistoryTextures.size(); ++i)
+		{
+			mHistoryTextures[i] = &mRenderTargets.acquire(levelSize);
+			mHistoryTextures[i]->setSmooth(true);
+		}
+	}
+	if (!mHistoryValid || mFramesSinceUpdate + 1 >= mUpdateInterval)
+	{
+		computeBloom(input, settings);
+		std::size_t next = 1 - mHistoryIndex;
+		const sf::RenderTexture& bloomLow = settings.secondLevel ? *mSecondPassTextures[0] : *mFirstPassTextures[0];
+		blendHistory(*mFirstPassTextures[0], bloomLow, settings.secondLevel ? 1.f : 0.f,
+			*mHistoryTextures[mHistoryIndex], *mHistoryTextures[next], mHistoryValid ? mHistoryWeight : 0.f);
+		releaseTextures();
+		mHistoryIndex = next;
+		mHistoryValid = true;
+		mFramesSinceUpdate = 0;
+	}
+	else
+	{
+		++mFramesSinceUpdate;
+	}
+	composite(input, *mHistoryTextures[mHistoryIndex], *mHistoryTextures[mHistoryIndex], output, 0.f);
+}
+
+void BloomEffect::computeBloom(const sf::RenderTexture& input, const QualitySettings& settings)
+{
+	acquireTextures(input.getSize());
+	// 高档位在全分辨率上取亮部并同时降采样，低档位直接在缩小的纹理上提取亮度
+	if (settings.fusedDownSample)
+		filterBrightDownSample(input, *mFirstPassTextures[0]);
+	else
+		filterBright(input, *mFirstPassTextures[0]);
+	blurMultipass(mFirstPassTextures, settings.blurIterations);
+	if (settings.secondLevel)
+	{
+		downsample(*mFirstPassTextures[0], *mSecondPassTextures[0]);
+		blurMultipass(mSecondPassTextures, settings.blurIterations);
+	}
+}
+
+void BloomEffect::setQuality(Quality quality)
+{
+	mQuality = quality;
+}
+
+BloomEffect::Quality BloomEffect::getQuality() const
+{
+	return mQuality;
+}
+
+void BloomEffect::setUpdateInterval(unsigned int frames)
+{
+	mUpdateInterval = frames;
+}
+
+void BloomEffect::setHistoryWeight(float weight)
+{
+	mHistoryWeight = weight;
+}
+
+const BloomEffect::Statistics& BloomEffect::getStatistics() const
+{
+	return mStatistics;
+}
+
+const char* BloomEffect::getQualityName(Quality quality)
+{
+	switch (quality)
+	{
+		case Off:		return "Off";
+		case Low:		return "Low";
+		case Medium:	return "Medium";
+		case High:		return "High";
+		default:		return "";
+	}
+}
+
+const char* BloomEffect::getPassName(PassType type)
+{
+	switch (type)
+	{
+		case CopyPass:				return "Copy";
+		case BrightnessPass:		return "Bright";
+		case BrightDownSamplePass:	return "Bright+Down";
+		case DownSamplePass:		return "Down";
+		case BlurPass:				return "Blur";
+		case CompositePass:			return "Composite";
+		case TemporalBlendPass:		return "Blend";
+		default:					return "";
+	}
+}
+
+void BloomEffect::acquireTextures(sf::Vector2u size)
+{
+	// 中间纹理只在本帧内从池中借用
+	const QualitySettings& settings = QualityTable[mQuality];
+	unsigned int divisor = settings.firstLevelDivisor;
+	for (std::size_t i = 0; i < mFirstPassTextures.size(); ++i)
+	{
+		mFirstPassTextures[i] = &mRenderTargets.acquire(sf::Vector2u(size.x / divisor, size.y / divisor));
+		mFirstPassTextures[i]->setSmooth(true);
+	}
+	if (settings.secondLevel)
+	{
+		for (std::size_t i = 0; i < mSecondPassTextures.size(); ++i)
+		{
+			mSecondPassTextures[i] = &mRenderTargets.acquire(sf::Vector2u(size.x / divisor / 2, size.y / divisor / 2));
+			mSecondPassTextures[i]->setSmooth(true);
+		}
+	}
+}
+
+void BloomEffect::releaseTextures()
+{
+	for (std::size_t i = 0; i < mFirstPassTextures.size(); ++i)
+	{
+		mRenderTargets.release(*mFirstPassTextures[i]);
+		mFirstPassTextures[i] = nullptr;
+	}
+	for (std::size_t i = 0; i < mSecondPassTextures.size(); ++i)
+	{
+		if (mSecondPassTextures[i])
+			mRenderTargets.release(*mSecondPassTextures[i]);
+		mSecondPassTextures[i] = nullptr;
+	}
 }
 
-void BloomEffect::prepareTextures(sf::Vector2u size)
+void BloomEffect::releaseHistory()
 {
-	if (mBrightnessTexture.getSize() != size)
+	for (std::size_t i = 0; i < mHistoryTextures.size(); ++i)
 	{
-		mBrightnessTexture.create(size.x, size.y);
-		mBrightnessTexture.setSmooth(true);
-		mFirstPassTextures[0].create(size.x / 2, size.y / 2);
-		mFirstPassTextures[0].setSmooth(true);
-		mFirstPassTextures[1].create(size.x / 2, size.y / 2);
-		mFirstPassTextures[1].setSmooth(true);
-		mSecondPassTextures[0].create(size.x / 4, size.y / 4);
-		mSecondPassTextures[0].setSmooth(true);
-		mSecondPassTextures[1].create(size.x / 4, size.y / 4);
-		mSecondPassTextures[1].setSmooth(true);
+		if (mHistoryTextures[i])
+			mRenderTargets.release(*mHistoryTextures[i]);
+		mHistoryTextures[i] = nullptr;
 	}
+	mHistoryValid = false;
+	mFramesSinceUpdate = 0;
+}
+
+void BloomEffect::copy(const sf::RenderTexture& input, sf::RenderTarget& output)
+{
+	beginPass();
+	// 输入可能是降低分辨率的场景纹理，拉伸到输出尺寸
+	sf::Sprite sprite(input.getTexture());
+	sf::Vector2f inputSize(input.getSize());
+	sf::Vector2f outputSize(output.getSize());
+	sprite.setScale(outputSize.x / inputSize.x, outputSize.y / inputSize.y);
+	output.setView(output.getDefaultView());
+	output.draw(sprite);
+	endPass(CopyPass);
 }
 
 void BloomEffect::filterBright(const sf::RenderTexture& input, sf::RenderTexture& output)
 {
+	beginPass();
 	sf::Shader& brightness = mShaders.get(Shaders::BrightnessPass);
 	brightness.setParameter("source", input.getTexture());
 	applyShader(brightness, output);
 	output.display();
+	endPass(BrightnessPass);
+}
+
+void BloomEffect::filterBrightDownSample(const sf::RenderTexture& input, sf::RenderTexture& output)
+{
+	beginPass();
+	sf::Shader& brightDownSampler = mShaders.get(Shaders::BrightDownSamplePass);
+	brightDownSampler.setParameter("source", input.getTexture());
+	brightDownSampler.setParameter("sourceSize", sf::Vector2f(input.getSize()));
+	applyShader(brightDownSampler, output);
+	output.display();
+	endPass(BrightDownSamplePass);
 }
 
-void BloomEffect::blurMultipass(RenderTextureArray& renderTextures)
+void BloomEffect::blurMultipass(RenderTextureArray& renderTextures, std::size_t iterations)
 {
-	sf::Vector2u textureSize = renderTextures[0].getSize();
-	for (std::size_t count = 0; count < 2; ++count)
+	sf::Vector2u textureSize = renderTextures[0]->getSize();
+	for (std::size_t count = 0; count < iterations; ++count)
 	{
-		blur(renderTextures[0], renderTextures[1], sf::Vector2f(0.f, 1.f / textureSize.y));
-		blur(renderTextures[1], renderTextures[0], sf::Vector2f(1.f / textureSize.x, 0.f));
+		blur(*renderTextures[0], *renderTextures[1], sf::Vector2f(0.f, 1.f / textureSize.y));
+		blur(*renderTextures[1], *renderTextures[0], sf::Vector2f(1.f / textureSize.x, 0.f));
 	}
 }
 
 void BloomEffect::blur(const sf::RenderTexture& input, sf::RenderTexture& output, sf::Vector2f offsetFactor)
 {
+	beginPass();
 	sf::Shader& gaussianBlur = mShaders.get(Shaders::GaussianBlurPass);
 	gaussianBlur.setParameter("source", input.getTexture());
 	gaussianBlur.setParameter("offsetFactor", offsetFactor);
 	applyShader(gaussianBlur, output);
 	output.display();
+	endPass(BlurPass);
 }
 
 void BloomEffect::downsample(const sf::RenderTexture& input, sf::RenderTexture& output)
 {
+	beginPass();
 	sf::Shader& downSampler = mShaders.get(Shaders::DownSamplePass);
 	downSampler.setParameter("source", input.getTexture());
 	downSampler.setParameter("sourceSize", sf::Vector2f(input.getSize()));
 	applyShader(downSampler, output);
 	output.display();
+	endPass(DownSamplePass);
+}
+
+void BloomEffect::composite(const sf::RenderTexture& source, const sf::RenderTexture& bloom,
+	const sf::RenderTexture& bloomLow, sf::RenderTarget& output, float bloomLowFactor)
+{
+	beginPass();
+	sf::Shader& compositor = mShaders.get(Shaders::CompositePass);
+	compositor.setParameter("source", source.getTexture());
+	compositor.setParameter("bloom", bloom.getTexture());
+	compositor.setParameter("bloomLow", bloomLow.getTexture());
+	compositor.setParameter("bloomLowFactor", bloomLowFactor);
+	applyShader(compositor, output);
+	endPass(CompositePass);
+}
+
+void BloomEffect::blendHistory(const sf::RenderTexture& bloom, const sf::RenderTexture& bloomLow, float bloomLowFactor,
+	const sf::RenderTexture& history, sf::RenderTexture& output, float historyWeight)
+{
+	beginPass();
+	sf::Shader& blender = mShaders.get(Shaders::TemporalBlendPass);
+	blender.setParameter("bloom", bloom.getTexture());
+	blender.setParameter("bloomLow", bloomLow.getTexture());
+	blender.setParameter("bloomLowFactor", bloomLowFactor);
+	blender.setParameter("history", history.getTexture());
+	blender.setParameter("historyWeight", historyWeight);
+	applyShader(blender, output);
+	output.display();
+	endPass(TemporalBlendPass);
+}
+
+void BloomEffect::beginPass()
+{
+	mPassClock.restart();
 }
 
-void BloomEffect::add(const sf::RenderTexture& source, const sf::RenderTexture& bloom, sf::RenderTarget& output)
+void BloomEffect::endPass(PassType type)
 {
-	sf::Shader& adder = mShaders.get(Shaders::AddPass);
-	adder.setParameter("source", source.getTexture());
-	adder.setParameter("bloom", bloom.getTexture());
-	applyShader(adder, output);
+	// 计时的是提交该遍绘制的CPU时间
+	mStatistics.passTimes[type] += mPassClock.getElapsedTime();
+	mStatistics.passCounts[type] += 1;
+	mStatistics.passCount += 1;
 }
@@ -0,0 +1,228 @@
+#include <Book/BulletSystem.hpp>
+#include <Book/DataTables.hpp>
+#include <Book/ResourceHolder.hpp>
+#include <Book/JobSystem.hpp>
+#include <Book/RenderSnapshot.hpp>
+#include <Book/Utility.hpp>
+#include <Book/CollisionMaskAtlas.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace
+{
+	const std::vector<ProjectileData> Table = initializeProjectileData();
+	const std::size_t IntegrateGrainSize = 2048;
+}
+
+BulletSystem::BulletSystem(const TextureHolder& textures, const CollisionMaskAtlas& masks)
+: SceneNode()
+, mTexture(textures.get(Table[Projectile::AlliedBullet].texture))
+, mTextureRects()
+, mMasks()
+, mPositionX()
+, mPositionY()
+, mPreviousX()
+, mPreviousY()
+, mVelocityX()
+, mVelocityY()
+, mDamage()
+, mTypes()
+, mSpent()
+, mVertexArray(sf::Quads)
+, mTargetOrder()
+, mTargetTops()
+{
+	// 所有子弹合并成一次绘制，要求使用同一张纹理
+	assert(Table[Projectile::EnemyBullet].texture == Table[Projectile::AlliedBullet].texture);
+	for (std::size_t i = 0; i < Projectile::TypeCount; ++i)
+	{
+		mTextureRects[i] = Table[i].textureRect;
+		mMasks[i] = masks.find(Table[i].textureRect, false);
+	}
+}
+
+void BulletSystem::addBullet(Projectile::Type type, sf::Vector2f position, sf::Vector2f direction)
+{
+	assert(type != Projectile::Missile);
+	sf::Vector2f velocity = direction * Table[type].speed;
+	mPositionX.push_back(position.x);
+	mPositionY.push_back(position.y);
+	mPreviousX.push_back(position.x);
+	mPreviousY.push_back(position.y);
+	mVelocityX.push_back(velocity.x);
+	mVelocityY.push_back(velocity.y);
+	mDamage.push_back(Table[type].damage);
+	mTypes.push_back(static_cast<sf::Uint8>(type));
+	mSpent.push_back(0);
+}
+
+void BulletSystem::updateBullets(sf::Time dt, sf::FloatRect bounds, JobSystem& jobs)
+{
+	removeSpentBullets(bounds);
+	// 记录上一步位置后移动，循环只访问连续的浮点数组，可以被编译器向量化
+	float seconds = dt.asSeconds();
+	jobs.parallelFor(mPositionX.size(), IntegrateGrainSize, [this, seconds] (std::size_t begin, std::size_t end)
+	{
+		float* x = mPositionX.data();
+		float* y = mPositionY.data();
+		float* previousX = mPreviousX.data();
+		float* previousY = mPreviousY.data();
+		const float* vx = mVelocityX.data();
+		const float* vy = mVelocityY.data();
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			previousX[i] = x[i];
+			previousY[i] = y[i];
+			x[i] += vx[i] * seconds;
+			y[i] += vy[i] * seconds;
+		}
+	});
+}
+
+void BulletSystem::collide(Projectile::Type type, const std::vector<sf::FloatRect>& targets,
+	const std::vector<PlacedMask>& targetMasks, std::vector<int>& damages, CollisionStatistics& statistics)
+{
+	// 一次查询处理一个阵营的全部子弹，damages 累加每个目标受到的伤害，计数累加到 statistics
+	damages.assign(targets.size(), 0);
+	if (targets.empty())
+		return;
+	// 目标按上边排序，记录最大高度；子弹用二分查找找出上边落在 [扫掠上边 - 最大高度, 扫掠下边) 的目标
+	mTargetOrder.resize(targets.size());
+	float maxHeight = 0.f;
+	for (std::size_t t = 0; t < targets.size(); ++t)
+	{
+		mTargetOrder[t] = t;
+		maxHeight = std::max(maxHeight, targets[t].height);
+	}
+	std::sort(mTargetOrder.begin(), mTargetOrder.end(), [&targets] (std::size_t lhs, std::size_t rhs)
+	{
+		return targets[lhs].top < targets[rhs].top;
+	});
+	mTargetTops.resize(targets.size());
+	for (std::size_t t = 0; t < targets.size(); ++t)
+		mTargetTops[t] = targets[mTargetOrder[t]].top;
+	// 子弹沿上一步的移动线段扫掠，目标在一步之内的移动远小于自身尺寸，按静止处理
+	const sf::FloatRect& hitBox = Table[type].hitBox;
+	const sf::IntRect& textureRect = mTextureRects[type];
+	for (std::size_t i = 0; i < mPositionX.size(); ++i)
+	{
+		if (mTypes[i] != type || mSpent[i])
+			continue;
+		sf::FloatRect bullet(mPositionX[i] + hitBox.left, mPositionY[i] + hitBox.top, hitBox.width, hitBox.height);
+		sf::Vector2f displacement(mPositionX[i] - mPreviousX[i], mPositionY[i] - mPreviousY[i]);
+		float sweptTop = bullet.top - std::max(displacement.y, 0.f);
+		float sweptBottom = bullet.top + bullet.height - std::min(displacement.y, 0.f);
+		std::vector<float>::const_iterator first = std::lower_bound(mTargetTops.begin(), mTargetTops.end(), sweptTop - maxHeight);
+		std::vector<float>::const_iterator last = std::lower_bound(first, mTargetTops.cend(), sweptBottom);
+		PlacedMask placed = {mMasks[type], sf::Vector2i(
+			static_cast<int>(std::floor(mPositionX[i] - textureRect.width / 2.f + 0.5f)),
+			static_cast<int>(std::floor(mPositionY[i] - textureRect.height / 2.f + 0.5f)))};
+		for (std::vector<float>::const_iterator top = first; top != last; ++top)
+		{
+			std::size_t t = mTargetOrder[top - mTargetTops.cbegin()];
+			++statistics.bulletTests;
+			if (!sweptIntersects(bullet, displacement, targets[t]))
+				continue;
+			// 结束位置仍与目标相交时比较像素遮罩，擦过透明机翼边角的子弹继续飞行
+			if (bullet.intersects(targets[t]))
+			{
+				++statistics.bulletMaskTests;
+				if (!overlaps(placed, targetMasks[t]))
+					continue;
+			}
+			damages[t] += mDamage[i];
+			mSpent[i] = 1;
+			++statistics.bulletHits;
+			break;
+		}
+	}
+}
+
+std::size_t BulletSystem::getBulletCount() const
+{
+	return mPositionX.size();
+}
+
+unsigned int BulletSystem::getCategory() const
+{
+	return Category::BulletSystem;
+}
+
+void BulletSystem::drawCurrentInterpolated(sf::RenderTarget& target, sf::RenderStates states, float alpha) const
+{
+	computeVertices(alpha);
+	states.texture = &mTexture;
+	target.draw(mVertexArray, states);
+}
+
+void BulletSystem::snapshotCurrentInterpolated(RenderSnapshot& snapshot, sf::RenderStates states, float alpha) const
+{
+	computeVertices(alpha);
+	states.texture = &mTexture;
+	snapshot.addToScene(mVertexArray, states);
+}
+
+void BulletSystem::computeVertices(float alpha) const
+{
+	// 每颗子弹四个顶点，位置在上一步与当前步之间插值
+	mVertexArray.resize(mPositionX.size() * 4);
+	for (std::size_t i = 0; i < mPositionX.size(); ++i)
+	{
+		const sf::IntRect& rect = mTextureRects[mTypes[i]];
+		float x = mPreviousX[i] + (mPositionX[i] - mPreviousX[i]) * alpha;
+		float y = mPreviousY[i] + (mPositionY[i] - mPreviousY[i]) * alpha;
+		float halfWidth = rect.width / 2.f;
+		float halfHeight = rect.height / 2.f;
+		float u = static_cast<float>(rect.left);
+		float v = static_cast<float>(rect.top);
+		sf::Vertex* quad = &mVertexArray[i * 4];
+		quad[0].position = sf::Vector2f(x - halfWidth, y - halfHeight);
+		quad[1].position = sf::Vector2f(x + halfWidth, y - halfHeight);
+		quad[2].position = sf::Vector2f(x + halfWidth, y + halfHeight);
+		quad[3].position = sf::Vector2f(x - halfWidth, y + halfHeight);
+		quad[0].texCoords = sf::Vector2f(u, v);
+		quad[1].texCoords = sf::Vector2f(u + rect.width, v);
+		quad[2].texCoords = sf::Vector2f(u + rect.width, v + rect.height);
+		quad[3].texCoords = sf::Vector2f(u, v + rect.height);
+	}
+}
+
+void BulletSystem::removeSpentBullets(sf::FloatRect bounds)
+{
+	// 保持顺序地压缩数组，去掉击中目标或离开战场的子弹
+	float right = bounds.left + bounds.width;
+	float bottom = bounds.top + bounds.height;
+	std::size_t count = 0;
+	for (std::size_t i = 0; i < mPositionX.size(); ++i)
+	{
+		float x = mPositionX[i];
+		float y = mPositionY[i];
+		if (mSpent[i] || x < bounds.left || x > right || y < bounds.top || y > bottom)
+			continue;
+		if (count != i)
+		{
+			mPositionX[count] = x;
+			mPositionY[count] = y;
+			mPreviousX[count] = mPreviousX[i];
+			mPreviousY[count] = mPreviousY[i];
+			mVelocityX[count] = mVelocityX[i];
+			mVelocityY[count] = mVelocityY[i];
+			mDamage[count] = mDamage[i];
+			mTypes[count] = mTypes[i];
+			mSpent[count] = 0;
+		}
+		++count;
+	}
+	mPositionX.resize(count);
+	mPositionY.resize(count);
+	mPreviousX.resize(count);
+	mPreviousY.resize(count);
+	mVelocityX.resize(count);
+	mVelocityY.resize(count);
+	mDamage.resize(count);
+	mTypes.resize(count);
+	mSpent.resize(count);
+}
@@ -2,6 +2,7 @@
 #include <Book/Utility.hpp>
 #include <Book/SoundPlayer.hpp>
 #include <Book/ResourceHolder.hpp>
+#include <Book/RenderSnapshot.hpp>
 #include <SFML/Window/Event.hpp>
 #include <SFML/Graphics/RenderStates.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
@@ -93,6 +94,13 @@ void Button::draw(sf::RenderTarget& target, sf::RenderStates states) const
 	target.draw(mText, states);
 }
 
+void Button::snapshot(RenderSnapshot& snapshot, sf::RenderStates states) const
+{
+	states.transform *= getTransform();
+	snapshot.addToOverlay(mSprite, states);
+	snapshot.addToOverlay(mText, states);
+}
+
 void Button::changeTexture(Type buttonType)
 {
 	sf::IntRect textureRect(0, 50*buttonType, 200, 50);
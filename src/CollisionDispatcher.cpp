@@ -0,0 +1,69 @@
+#include <Book/CollisionDispatcher.hpp>
+#include <Book/SceneNode.hpp>
+
+CollisionDispatcher::CollisionDispatcher()
+: mCollisionMasks()
+, mResponses()
+{
+	mCollisionMasks.fill(0);
+	for (std::size_t i = 0; i < mResponses.size(); ++i)
+		mResponses[i].swapped = false;
+}
+
+unsigned int CollisionDispatcher::getCollisionMask(unsigned int category) const
+{
+	if (category == Category::None)
+		return 0;
+	return mCollisionMasks[getLayer(category)];
+}
+
+bool CollisionDispatcher::dispatch(SceneNode& lhs, unsigned int lhsCategory, SceneNode& rhs, unsigned int rhsCategory) const
+{
+	const Entry& entry = mResponses[getLayer(lhsCategory) * LayerCount + getLayer(rhsCategory)];
+	if (!entry.response)
+		return false;
+	// 登记顺序与检测到的顺序相反时交换参数
+	if (entry.swapped)
+		entry.response(rhs, lhs);
+	else
+		entry.response(lhs, rhs);
+	return true;
+}
+
+void CollisionDispatcher::insertResponse(unsigned int first, unsigned int second, Response response)
+{
+	// 组合类别（例如 Category::Aircraft）展开到其中的每一位，两个方向都登记
+	for (std::size_t i = 0; i < LayerCount; ++i)
+	{
+		if (!(first & (1u << i)))
+			continue;
+		for (std::size_t j = 0; j < LayerCount; ++j)
+		{
+			if (!(second & (1u << j)))
+				continue;
+			mResponses[i * LayerCount + j].response = response;
+			mResponses[i * LayerCount + j].swapped = false;
+			if (i != j)
+			{
+				mResponses[j * LayerCount + i].response = response;
+				mResponses[j * LayerCount + i].swapped = true;
+			}
+			mCollisionMasks[i] |= 1u << j;
+			mCollisionMasks[j] |= 1u << i;
+		}
+	}
+}
+
+std::size_t CollisionDispatcher::getLayer(unsigned int category)
+{
+	// 实体的类别只有一位
+	assert(category != 0 && (category & (category - 1)) == 0);
+	std::size_t layer = 0;
+	while (!(category & 1u))
+	{
+		category >>= 1;
+		++layer;
+	}
+	assert(layer < LayerCount);
+	return layer;
+}
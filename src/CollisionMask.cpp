@@ -0,0 +1,90 @@
+#include <Book/CollisionMask.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <algorithm>
+
+namespace
+{
+	const int			WordBits = 64;
+	// 透明度不低于一半的像素算作实体的一部分
+	const sf::Uint8		AlphaThreshold = 128;
+}
+
+CollisionMask::CollisionMask()
+: mWidth(0)
+, mHeight(0)
+, mWordsPerRow(0)
+, mBits()
+{
+}
+
+CollisionMask::CollisionMask(const sf::Image& image, const sf::IntRect& rect, bool rotated)
+: mWidth(rect.width)
+, mHeight(rect.height)
+, mWordsPerRow((rect.width + WordBits - 1) / WordBits)
+, mBits(static_cast<std::size_t>(mWordsPerRow * rect.height), 0)
+{
+	// 旋转 180 度的敌机直接生成翻转后的遮罩，比较时不需要再变换坐标
+	for (int y = 0; y < mHeight; ++y)
+	{
+		for (int x = 0; x < mWidth; ++x)
+		{
+			int sourceX = rotated ? mWidth - 1 - x : x;
+			int sourceY = rotated ? mHeight - 1 - y : y;
+			sf::Color pixel = image.getPixel(rect.left + sourceX, rect.top + sourceY);
+			if (pixel.a >= AlphaThreshold)
+				mBits[y * mWordsPerRow + x / WordBits] |= sf::Uint64(1) << (x % WordBits);
+		}
+	}
+}
+
+sf::Vector2i CollisionMask::getSize() const
+{
+	return sf::Vector2i(mWidth, mHeight);
+}
+
+bool CollisionMask::overlaps(const CollisionMask& other, sf::Vector2i offset) const
+{
+	// offset 为另一个遮罩左上角相对于本遮罩左上角的位置，只遍历两者重叠的行和字
+	int top = std::max(0, offset.y);
+	int bottom = std::min(mHeight, offset.y + other.mHeight);
+	int left = std::max(0, offset.x);
+	int right = std::min(mWidth, offset.x + other.mWidth);
+	if (left >= right || top >= bottom)
+		return false;
+	int firstWord = left / WordBits;
+	int lastWord = (right - 1) / WordBits;
+	for (int y = top; y < bottom; ++y)
+	{
+		const sf::Uint64* row = &mBits[y * mWordsPerRow];
+		for (int word = firstWord; word <= lastWord; ++word)
+		{
+			// 重叠范围之外的位在另一个遮罩中读出为 0，不需要额外屏蔽
+			if (row[word] & other.readBits(y - offset.y, word * WordBits - offset.x))
+				return true;
+		}
+	}
+	return false;
+}
+
+sf::Uint64 CollisionMask::readBits(int row, int column) const
+{
+	// 读出从 column 开始的 64 列，列号可以为负或超出宽度，范围外的位为 0
+	if (column <= -WordBits || column >= mWidth)
+		return 0;
+	const sf::Uint64* bits = &mBits[row * mWordsPerRow];
+	if (column < 0)
+		return bits[0] << -column;
+	int word = column / WordBits;
+	int shift = column % WordBits;
+	sf::Uint64 value = bits[word] >> shift;
+	if (shift != 0 && word + 1 < mWordsPerRow)
+		value |= bits[word + 1] << (WordBits - shift);
+	return value;
+}
+
+bool overlaps(const PlacedMask& lhs, const PlacedMask& rhs)
+{
+	if (!lhs.mask || !rhs.mask)
+		return true;
+	return lhs.mask->overlaps(*rhs.mask, rhs.position - lhs.position);
+}
@@ -0,0 +1,31 @@
+#include <Book/CollisionMaskAtlas.hpp>
+#include <Book/Foreach.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Image.hpp>
+
+CollisionMaskAtlas::CollisionMaskAtlas()
+: mMasks()
+{
+}
+
+void CollisionMaskAtlas::build(const sf::Texture& texture, const std::vector<sf::IntRect>& rects)
+{
+	// 只在载入时从显存读回一次图集
+	sf::Image image = texture.copyToImage();
+	FOREACH(const sf::IntRect& rect, rects)
+	{
+		mMasks[Key(rect.left, rect.top, rect.width, rect.height, false)] = CollisionMask(image, rect, false);
+		mMasks[Key(rect.left, rect.top, rect.width, rect.height, true)] = CollisionMask(image, rect, true);
+	}
+}
+
+const CollisionMask* CollisionMaskAtlas::find(const sf::IntRect& rect, bool rotated) const
+{
+	auto found = mMasks.find(Key(rect.left, rect.top, rect.width, rect.height, rotated));
+	return (found != mMasks.end()) ? &found->second : nullptr;
+}
+
+std::size_t CollisionMaskAtlas::getMaskCount() const
+{
+	return mMasks.size();
+}
@@ -1,5 +1,6 @@
 #include <Book/Container.hpp>
 #include <Book/Foreach.hpp>
+#include <Book/RenderSnapshot.hpp>
 #include <SFML/Window/Event.hpp>
 #include <SFML/Graphics/RenderStates.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
@@ -57,6 +58,13 @@ void Container::draw(sf::RenderTarget& target, sf::RenderStates states) const
 		target.draw(*child, states);
 }
 
+void Container::snapshot(RenderSnapshot& snapshot, sf::RenderStates states) const
+{
+    states.transform *= getTransform();
+	FOREACH(const Component::Ptr& child, mChildren)
+		child->snapshot(snapshot, states);
+}
+
 bool Container::hasSelection() const
 {
 	return mSelectedChild >= 0;
@@ -0,0 +1,408 @@
+#include <Book/CpuBloomEffect.hpp>
+#include <Book/JobSystem.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BOOK_CPUBLOOM_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	// 每个像素的RGBA正好是一个4分量向量
+#ifdef BOOK_CPUBLOOM_SSE2
+	typedef __m128 Vec4;
+
+	inline Vec4 load(const float* p)			{ return _mm_loadu_ps(p); }
+	inline void store(float* p, Vec4 v)			{ _mm_storeu_ps(p, v); }
+	inline Vec4 splat(float f)					{ return _mm_set1_ps(f); }
+	inline Vec4 add(Vec4 a, Vec4 b)				{ return _mm_add_ps(a, b); }
+	inline Vec4 mul(Vec4 a, Vec4 b)				{ return _mm_mul_ps(a, b); }
+
+	inline Vec4 loadBytes(const sf::Uint8* p)
+	{
+		int packed;
+		std::memcpy(&packed, p, 4);
+		__m128i zero = _mm_setzero_si128();
+		__m128i words = _mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero);
+		return _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(words, zero)), _mm_set1_ps(1.f / 255.f));
+	}
+
+	inline void storeBytes(sf::Uint8* p, Vec4 v)
+	{
+		v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.f));
+		__m128i ints = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(255.f)), _mm_set1_ps(0.5f)));
+		__m128i words = _mm_packs_epi32(ints, ints);
+		int packed = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+		std::memcpy(p, &packed, 4);
+	}
+
+	inline float luminance(Vec4 v)
+	{
+		Vec4 weighted = _mm_mul_ps(v, _mm_set_ps(0.f, 0.0722f, 0.7152f, 0.2126f));
+		Vec4 shuffled = _mm_shuffle_ps(weighted, weighted, _MM_SHUFFLE(2, 3, 0, 1));
+		Vec4 sums = _mm_add_ps(weighted, shuffled);
+		shuffled = _mm_movehl_ps(shuffled, sums);
+		return _mm_cvtss_f32(_mm_add_ss(sums, shuffled));
+	}
+#else
+	struct Vec4
+	{
+		float v[4];
+	};
+
+	inline Vec4 load(const float* p)			{ Vec4 r; std::memcpy(r.v, p, sizeof(r.v)); return r; }
+	inline void store(float* p, Vec4 v)			{ std::memcpy(p, v.v, sizeof(v.v)); }
+	inline Vec4 splat(float f)					{ Vec4 r = {{ f, f, f, f }}; return r; }
+	inline Vec4 add(Vec4 a, Vec4 b)				{ Vec4 r = {{ a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] }}; return r; }
+	inline Vec4 mul(Vec4 a, Vec4 b)				{ Vec4 r = {{ a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] }}; return r; }
+
+	inline Vec4 loadBytes(const sf::Uint8* p)
+	{
+		Vec4 r = {{ p[0] / 255.f, p[1] / 255.f, p[2] / 255.f, p[3] / 255.f }};
+		return r;
+	}
+
+	inline void storeBytes(sf::Uint8* p, Vec4 v)
+	{
+		for (int i = 0; i < 4; ++i)
+			p[i] = static_cast<sf::Uint8>(std::min(std::max(v.v[i], 0.f), 1.f) * 255.f + 0.5f);
+	}
+
+	inline float luminance(Vec4 v)
+	{
+		return v.v[0] * 0.2126f + v.v[1] * 0.7152f + v.v[2] * 0.0722f;
+	}
+#endif
+
+	// 与 Brightness.frag 相同的阈值和系数
+	const float BrightThreshold = 0.7f;
+	const float BrightFactor = 4.f;
+	// 5阶二项式核，近似高斯模糊
+	const float BlurWeights[5] = { 1.f / 16.f, 4.f / 16.f, 6.f / 16.f, 4.f / 16.f, 1.f / 16.f };
+	const std::size_t RowGrainSize = 16;
+
+	inline Vec4 bright(Vec4 color)
+	{
+		float factor = std::min(std::max(luminance(color) - BrightThreshold, 0.f), 1.f) * BrightFactor;
+		return mul(color, splat(factor));
+	}
+
+	inline unsigned int clampIndex(int index, unsigned int size)
+	{
+		return static_cast<unsigned int>(std::min(std::max(index, 0), static_cast<int>(size) - 1));
+	}
+}
+
+void CpuBloomEffect::Buffer::resize(unsigned int newWidth, unsigned int newHeight)
+{
+	width = std::max(newWidth, 1u);
+	height = std::max(newHeight, 1u);
+	pixels.resize(static_cast<std::size_t>(width) * height * 4);
+}
+
+CpuBloomEffect::CpuBloomEffect(JobSystem& jobs)
+: mJobs(jobs)
+, mQuality(BloomEffect::High)
+, mFirstLevel()
+, mSecondLevel()
+, mTemporary()
+, mUpdateInterval(1)
+, mHistoryWeight(0.5f)
+, mFirstHistory()
+, mSecondHistory()
+, mHistoryValid(false)
+, mFramesSinceUpdate(0)
+, mResultPixels()
+, mResultTexture()
+, mStatistics()
+, mPassClock()
+{
+}
+
+void CpuBloomEffect::apply(const sf::RenderTexture& input, sf::RenderTarget& output)
+{
+	mStatistics = BloomEffect::Statistics();
+	mStatistics.quality = mQuality;
+	if (mQuality == BloomEffect::Off)
+	{
+		mHistoryValid = false;
+		beginPass();
+		present(input, output, input.getTexture());
+		endPass(BloomEffect::CopyPass);
+		return;
+	}
+	// 读回场景图像，之后的每一步都按行分给工作线程
+	beginPass();
+	sf::Image image = input.getTexture().copyToImage();
+	endPass(BloomEffect::CopyPass);
+	const sf::Uint8* source = image.getPixelsPtr();
+	sf::Vector2u size = image.getSize();
+	bool secondLevel = (mQuality != BloomEffect::Low);
+	unsigned int divisor = secondLevel ? 2 : 4;
+	// 与GPU路径相同的时间复用：每隔若干帧才重新计算泛光，其余帧只读回和合成
+	bool temporal = (mUpdateInterval > 1);
+	bool sizeChanged = (mFirstHistory.width != std::max(size.x / divisor, 1u)
+		|| mFirstHistory.height != std::max(size.y / divisor, 1u));
+	if (!temporal || sizeChanged)
+		mHistoryValid = false;
+	if (!temporal || !mHistoryValid || mFramesSinceUpdate + 1 >= mUpdateInterval)
+	{
+		filterBrightDownSample(source, size.x, size.y, divisor, mFirstLevel);
+		blur(mFirstLevel, mTemporary);
+		if (secondLevel)
+		{
+			downsample(mFirstLevel, mSecondLevel);
+			blur(mSecondLevel, mTemporary);
+		}
+		else
+		{
+			mSecondLevel.resize(1, 1);
+			std::fill(mSecondLevel.pixels.begin(), mSecondLevel.pixels.end(), 0.f);
+		}
+		if (temporal)
+		{
+			blendHistory(mHistoryValid ? mHistoryWeight : 0.f);
+			mHistoryValid = true;
+		}
+		mFramesSinceUpdate = 0;
+	}
+	else
+	{
+		++mFramesSinceUpdate;
+	}
+	if (temporal)
+		composite(source, size.x, size.y, mFirstHistory, mSecondHistory);
+	else
+		composite(source, size.x, size.y, mFirstLevel, mSecondLevel);
+	// 上传结果并绘制到输出
+	beginPass();
+	if (mResultTexture.getSize() != size)
+		mResultTexture.create(size.x, size.y);
+	mResultTexture.setSmooth(input.isSmooth());
+	mResultTexture.update(&mResultPixels[0]);
+	present(input, output, mResultTexture);
+	endPass(BloomEffect::CopyPass);
+}
+
+void CpuBloomEffect::setQuality(BloomEffect::Quality quality)
+{
+	// 档位决定是否有第二级，切换后历史不能再混合
+	if (quality != mQuality)
+		mHistoryValid = false;
+	mQuality = quality;
+}
+
+BloomEffect::Quality CpuBloomEffect::getQuality() const
+{
+	return mQuality;
+}
+
+void CpuBloomEffect::setUpdateInterval(unsigned int frames)
+{
+	mUpdateInterval = frames;
+}
+
+void CpuBloomEffect::setHistoryWeight(float weight)
+{
+	mHistoryWeight = weight;
+}
+
+const BloomEffect::Statistics& CpuBloomEffect::getStatistics() const
+{
+	return mStatistics;
+}
+
+void CpuBloomEffect::filterBrightDownSample(const sf::Uint8* source, unsigned int width, unsigned int height,
+	unsigned int divisor, Buffer& output)
+{
+	beginPass();
+	output.resize(width / divisor, height / divisor);
+	Vec4 scale = splat(1.f / (divisor * divisor));
+	mJobs.parallelFor(output.height, RowGrainSize, [&] (std::size_t begin, std::size_t end)
+	{
+		for (std::size_t y = begin; y < end; ++y)
+		{
+			float* row = &output.pixels[y * output.width * 4];
+			for (unsigned int x = 0; x < output.width; ++x)
+			{
+				// 对每个源像素先取亮部再求平均，与合并后的着色器一致
+				Vec4 sum = splat(0.f);
+				for (unsigned int dy = 0; dy < divisor; ++dy)
+				{
+					unsigned int sy = clampIndex(static_cast<int>(y * divisor + dy), height);
+					const sf::Uint8* sourceRow = source + static_cast<std::size_t>(sy) * width * 4;
+					for (unsigned int dx = 0; dx < divisor; ++dx)
+					{
+						unsigned int sx = clampIndex(static_cast<int>(x * divisor + dx), width);
+						sum = add(sum, bright(loadBytes(sourceRow + sx * 4)));
+					}
+				}
+				store(row + x * 4, mul(sum, scale));
+			}
+		}
+	});
+	endPass(BloomEffect::BrightDownSamplePass);
+}
+
+void CpuBloomEffect::downsample(const Buffer& input, Buffer& output)
+{
+	beginPass();
+	output.resize(input.width / 2, input.height / 2);
+	mJobs.parallelFor(output.height, RowGrainSize, [&] (std::size_t begin, std::size_t end)
+	{
+		for (std::size_t y = begin; y < end; ++y)
+		{
+			const float* top = &input.pixels[clampIndex(static_cast<int>(y * 2), input.height) * input.width * 4];
+			const float* bottom = &input.pixels[clampIndex(static_cast<int>(y * 2 + 1), input.height) * input.width * 4];
+			float* row = &output.pixels[y * output.width * 4];
+			for (unsigned int x = 0; x < output.width; ++x)
+			{
+				unsigned int left = clampIndex(static_cast<int>(x * 2), input.width) * 4;
+				unsigned int right = clampIndex(static_cast<int>(x * 2 + 1), input.width) * 4;
+				Vec4 sum = add(add(load(top + left), load(top + right)), add(load(bottom + left), load(bottom + right)));
+				store(row + x * 4, mul(sum, splat(0.25f)));
+			}
+		}
+	});
+	endPass(BloomEffect::DownSamplePass);
+}
+
+void CpuBloomEffect::blur(Buffer& buffer, Buffer& temporary)
+{
+	// 可分离的高斯模糊：先水平写入临时缓冲，再垂直写回
+	beginPass();
+	temporary.resize(buffer.width, buffer.height);
+	mJobs.parallelFor(buffer.height, RowGrainSize, [&] (std::size_t begin, std::size_t end)
+	{
+		for (std::size_t y = begin; y < end; ++y)
+		{
+			const float* source = &buffer.pixels[y * buffer.width * 4];
+			float* row = &temporary.pixels[y * buffer.width * 4];
+			for (unsigned int x = 0; x < buffer.width; ++x)
+			{
+				Vec4 sum = splat(0.f);
+				for (int k = -2; k <= 2; ++k)
+					sum = add(sum, mul(load(source + clampIndex(static_cast<int>(x) + k, buffer.width) * 4), splat(BlurWeights[k + 2])));
+				store(row + x * 4, sum);
+			}
+		}
+	});
+	endPass(BloomEffect::BlurPass);
+	beginPass();
+	mJobs.parallelFor(buffer.height, RowGrainSize, [&] (std::size_t begin, std::size_t end)
+	{
+		for (std::size_t y = begin; y < end; ++y)
+		{
+			const float* rows[5];
+			for (int k = -2; k <= 2; ++k)
+				rows[k + 2] = &temporary.pixels[clampIndex(static_cast<int>(y) + k, buffer.height) * buffer.width * 4];
+			float* row = &buffer.pixels[y * buffer.width * 4];
+			for (unsigned int x = 0; x < buffer.width; ++x)
+			{
+				Vec4 sum = splat(0.f);
+				for (int k = 0; k < 5; ++k)
+					sum = add(sum, mul(load(rows[k] + x * 4), splat(BlurWeights[k])));
+				store(row + x * 4, sum);
+			}
+		}
+	});
+	endPass(BloomEffect::BlurPass);
+}
+
+void CpuBloomEffect::blendHistory(float historyWeight)
+{
+	// 新计算的两级泛光与历史按权重混合，结果留在历史缓冲中
+	beginPass();
+	const Buffer* levels[2] = { &mFirstLevel, &mSecondLevel };
+	Buffer* histories[2] = { &mFirstHistory, &mSecondHistory };
+	Vec4 currentFactor = splat(1.f - historyWeight);
+	Vec4 historyFactor = splat(historyWeight);
+	for (int i = 0; i < 2; ++i)
+	{
+		const Buffer& level = *levels[i];
+		Buffer& history = *histories[i];
+		if (history.width != level.width || history.height != level.height)
+			history.resize(level.width, level.height);
+		mJobs.parallelFor(level.height, RowGrainSize, [&] (std::size_t begin, std::size_t end)
+		{
+			std::size_t rowSize = static_cast<std::size_t>(level.width) * 4;
+			for (std::size_t y = begin; y < end; ++y)
+			{
+				const float* current = &level.pixels[y * rowSize];
+				float* row = &history.pixels[y * rowSize];
+				for (std::size_t x = 0; x < rowSize; x += 4)
+					store(row + x, add(mul(load(current + x), currentFactor), mul(load(row + x), historyFactor)));
+			}
+		});
+	}
+	endPass(BloomEffect::TemporalBlendPass);
+}
+
+void CpuBloomEffect::composite(const sf::Uint8* source, unsigned int width, unsigned int height,
+	const Buffer& firstLevel, const Buffer& secondLevel)
+{
+	beginPass();
+	mResultPixels.resize(static_cast<std::size_t>(width) * height * 4);
+	// 两级泛光双线性放大后叠加到原图
+	const Buffer* levels[2] = { &firstLevel, &secondLevel };
+	mJobs.parallelFor(height, RowGrainSize, [&] (std::size_t begin, std::size_t end)
+	{
+		for (std::size_t y = begin; y < end; ++y)
+		{
+			const sf::Uint8* sourceRow = source + y * width * 4;
+			sf::Uint8* row = &mResultPixels[y * width * 4];
+			for (unsigned int x = 0; x < width; ++x)
+			{
+				Vec4 color = loadBytes(sourceRow + x * 4);
+				for (int i = 0; i < 2; ++i)
+				{
+					const Buffer& level = *levels[i];
+					float fx = std::max((x + 0.5f) * level.width / width - 0.5f, 0.f);
+					float fy = std::max((y + 0.5f) * level.height / height - 0.5f, 0.f);
+					unsigned int x0 = std::min(static_cast<unsigned int>(fx), level.width - 1);
+					unsigned int y0 = std::min(static_cast<unsigned int>(fy), level.height - 1);
+					unsigned int x1 = std::min(x0 + 1, level.width - 1);
+					unsigned int y1 = std::min(y0 + 1, level.height - 1);
+					float tx = fx - x0;
+					float ty = fy - y0;
+					const float* top = &level.pixels[y0 * level.width * 4];
+					const float* bottom = &level.pixels[y1 * level.width * 4];
+					Vec4 upper = add(mul(load(top + x0 * 4), splat(1.f - tx)), mul(load(top + x1 * 4), splat(tx)));
+					Vec4 lower = add(mul(load(bottom + x0 * 4), splat(1.f - tx)), mul(load(bottom + x1 * 4), splat(tx)));
+					color = add(color, add(mul(upper, splat(1.f - ty)), mul(lower, splat(ty))));
+				}
+				storeBytes(row + x * 4, color);
+			}
+		}
+	});
+	endPass(BloomEffect::CompositePass);
+}
+
+void CpuBloomEffect::present(const sf::RenderTexture& input, sf::RenderTarget& output, const sf::Texture& texture)
+{
+	// 输入可能是降低分辨率的场景纹理，拉伸到输出尺寸
+	sf::Sprite sprite(texture);
+	sf::Vector2f inputSize(input.getSize());
+	sf::Vector2f outputSize(output.getSize());
+	sprite.setScale(outputSize.x / inputSize.x, outputSize.y / inputSize.y);
+	output.setView(output.getDefaultView());
+	output.draw(sprite);
+}
+
+void CpuBloomEffect::beginPass()
+{
+	mPassClock.restart();
+}
+
+void CpuBloomEffect::endPass(BloomEffect::PassType type)
+{
+	mStatistics.passTimes[type] += mPassClock.getElapsedTime();
+	mStatistics.passCounts[type] += 1;
+	mStatistics.passCount += 1;
+}
@@ -14,11 +14,13 @@ std::vector<AircraftData> initializeAircraftData()
 	data[Aircraft::Eagle].fireInterval = sf::seconds(1);
 	data[Aircraft::Eagle].texture = Textures::Entities;
 	data[Aircraft::Eagle].textureRect = sf::IntRect(0, 0, 48, 64);
+	data[Aircraft::Eagle].hitBox = sf::FloatRect(-20.f, -28.f, 40.f, 56.f);
 	data[Aircraft::Eagle].hasRollAnimation = true;
 	data[Aircraft::Raptor].hitpoints = 20;
 	data[Aircraft::Raptor].speed = 80.f;
 	data[Aircraft::Raptor].texture = Textures::Entities;
 	data[Aircraft::Raptor].textureRect = sf::IntRect(144, 0, 84, 64);
+	data[Aircraft::Raptor].hitBox = sf::FloatRect(-36.f, -24.f, 72.f, 48.f);
 	data[Aircraft::Raptor].directions.push_back(Direction(+45.f, 80.f));
 	data[Aircraft::Raptor].directions.push_back(Direction(-45.f, 160.f));
 	data[Aircraft::Raptor].directions.push_back(Direction(+45.f, 80.f));
@@ -28,6 +30,7 @@ std::vector<AircraftData> initializeAircraftData()
 	data[Aircraft::Avenger].speed = 50.f;
 	data[Aircraft::Avenger].texture = Textures::Entities;
 	data[Aircraft::Avenger].textureRect = sf::IntRect(228, 0, 60, 59);
+	data[Aircraft::Avenger].hitBox = sf::FloatRect(-26.f, -24.f, 52.f, 48.f);
 	data[Aircraft::Avenger].directions.push_back(Direction(+45.f,  50.f));
 	data[Aircraft::Avenger].directions.push_back(Direction(  0.f,  50.f));
 	data[Aircraft::Avenger].directions.push_back(Direction(-45.f, 100.f));
@@ -45,14 +48,17 @@ std::vector<ProjectileData> initializeProjectileData()
 	data[Projectile::AlliedBullet].speed = 300.f;
 	data[Projectile::AlliedBullet].texture = Textures::Entities;
 	data[Projectile::AlliedBullet].textureRect = sf::IntRect(175, 64, 3, 14);
+	data[Projectile::AlliedBullet].hitBox = sf::FloatRect(-1.5f, -7.f, 3.f, 14.f);
 	data[Projectile::EnemyBullet].damage = 10;
 	data[Projectile::EnemyBullet].speed = 300.f;
 	data[Projectile::EnemyBullet].texture = Textures::Entities;
 	data[Projectile::EnemyBullet].textureRect = sf::IntRect(178, 64, 3, 14);
+	data[Projectile::EnemyBullet].hitBox = sf::FloatRect(-1.5f, -7.f, 3.f, 14.f);
 	data[Projectile::Missile].damage = 200;
 	data[Projectile::Missile].speed = 150.f;
 	data[Projectile::Missile].texture = Textures::Entities;
 	data[Projectile::Missile].textureRect = sf::IntRect(160, 64, 15, 32);
+	data[Projectile::Missile].hitBox = sf::FloatRect(-5.f, -16.f, 10.f, 32.f);
 	return data;
 }
 
@@ -61,15 +67,19 @@ std::vector<PickupData> initializePickupData()
 	std::vector<PickupData> data(Pickup::TypeCount);
 	data[Pickup::HealthRefill].texture = Textures::Entities;
 	data[Pickup::HealthRefill].textureRect = sf::IntRect(0, 64, 40, 40);
+	data[Pickup::HealthRefill].hitBox = sf::FloatRect(-18.f, -18.f, 36.f, 36.f);
 	data[Pickup::HealthRefill].action = [] (Aircraft& a) { a.repair(25); };
 	data[Pickup::MissileRefill].texture = Textures::Entities;
 	data[Pickup::MissileRefill].textureRect = sf::IntRect(40, 64, 40, 40);
+	data[Pickup::MissileRefill].hitBox = sf::FloatRect(-18.f, -18.f, 36.f, 36.f);
 	data[Pickup::MissileRefill].action = std::bind(&Aircraft::collectMissiles, _1, 3);
 	data[Pickup::FireSpread].texture = Textures::Entities;
 	data[Pickup::FireSpread].textureRect = sf::IntRect(80, 64, 40, 40);
+	data[Pickup::FireSpread].hitBox = sf::FloatRect(-18.f, -18.f, 36.f, 36.f);
 	data[Pickup::FireSpread].action = std::bind(&Aircraft::increaseSpread, _1);
 	data[Pickup::FireRate].texture = Textures::Entities;
 	data[Pickup::FireRate].textureRect = sf::IntRect(120, 64, 40, 40);
+	data[Pickup::FireRate].hitBox = sf::FloatRect(-18.f, -18.f, 36.f, 36.f);
 	data[Pickup::FireRate].action = std::bind(&Aircraft::increaseFireRate, _1);
 	return data;
 }
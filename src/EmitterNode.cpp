@@ -1,35 +1,17 @@
 #include <Book/EmitterNode.hpp>
 #include <Book/ParticleNode.hpp>
-#include <Book/CommandQueue.hpp>
-#include <Book/Command.hpp>
+#include <Book/ParticleRegistry.hpp>
 
-EmitterNode::EmitterNode(Particle::Type type)
+EmitterNode::EmitterNode(Particle::Type type, const ParticleRegistry& particles)
 : SceneNode()
 , mAccumulatedTime(sf::Time::Zero)
-, mType(type)
-, mParticleSystem(nullptr)
+, mParticleSystem(particles.get(type))
 {
 }
 
-void EmitterNode::updateCurrent(sf::Time dt, CommandQueue& commands)
+void EmitterNode::updateCurrent(sf::Time dt, CommandQueue&)
 {
-	if (mParticleSystem)
-	{
-		emitParticles(dt);
-	}
-	else
-	{
-		// ҵ뷢ڵͬ͵ӵڵ
-		auto finder = [this] (ParticleNode& container, sf::Time)
-		{
-			if (container.getParticleType() == mType)
-				mParticleSystem = &container;
-		};
-		Command command;
-		command.category = Category::ParticleSystem;
-		command.action = derivedAction<ParticleNode>(finder);
-		commands.push(command);
-	}
+	emitParticles(dt);
 }
 
 void EmitterNode::emitParticles(sf::Time dt)
@@ -37,9 +19,13 @@ void EmitterNode::emitParticles(sf::Time dt)
 	const float emissionRate = 30.f;
 	const sf::Time interval = sf::seconds(1.f) / emissionRate;
 	mAccumulatedTime += dt;
+	// Ӧһдϵͳ
+	std::size_t count = 0;
 	while (mAccumulatedTime > interval)
 	{
 		mAccumulatedTime -= interval;
-		mParticleSystem->addParticle(getWorldPosition());
+		++count;
 	}
+	if (count > 0)
+		mParticleSystem.addParticles(getWorldPosition(), count);
 }
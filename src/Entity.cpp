@@ -1,59 +1,68 @@
 #include <Book/Entity.hpp>
+#include <Book/EntityStore.hpp>
+#include <Book/CollisionMaskAtlas.hpp>
 #include <cassert>
+#include <cmath>
 
-Entity::Entity(int hitpoints)
-: mVelocity()
-, mHitpoints(hitpoints)
+Entity::Entity(EntityStore& store, int hitpoints)
+: mStore(store)
+, mStoreIndex(store.insert(*this, hitpoints))
 {
 }
 
+Entity::~Entity()
+{
+	mStore.erase(mStoreIndex);
+}
+
 void Entity::setVelocity(sf::Vector2f velocity)
 {
-	mVelocity = velocity;
+	mStore.mVelocities[mStoreIndex] = velocity;
 }
 
 void Entity::setVelocity(float vx, float vy)
 {
-	mVelocity.x = vx;
-	mVelocity.y = vy;
+	mStore.mVelocities[mStoreIndex] = sf::Vector2f(vx, vy);
 }
 
 sf::Vector2f Entity::getVelocity() const
 {
-	return mVelocity;
+	return mStore.mVelocities[mStoreIndex];
 }
 
 void Entity::accelerate(sf::Vector2f velocity)
 {
-	mVelocity += velocity;
+	mStore.mVelocities[mStoreIndex] += velocity;
 }
 
 void Entity::accelerate(float vx, float vy)
 {
-	mVelocity.x += vx;
-	mVelocity.y += vy;
+	mStore.mVelocities[mStoreIndex] += sf::Vector2f(vx, vy);
 }
 
 int Entity::getHitpoints() const
 {
-	return mHitpoints;
+	return mStore.mHitpoints[mStoreIndex];
 }
 
 void Entity::repair(int points)
 {
 	assert(points > 0);
-	mHitpoints += points;
+	mStore.mHitpoints[mStoreIndex] += points;
 }
 
 void Entity::damage(int points)
 {
 	assert(points > 0);
-	mHitpoints -= points;
+	mStore.mHitpoints[mStoreIndex] -= points;
+	if (mStore.mHitpoints[mStoreIndex] <= 0)
+		mStore.addWreck(mStoreIndex);
 }
 
 void Entity::destroy()
 {
-	mHitpoints = 0;
+	mStore.mHitpoints[mStoreIndex] = 0;
+	mStore.addWreck(mStoreIndex);
 }
 
 void Entity::remove()
@@ -63,10 +72,41 @@ void Entity::remove()
 
 bool Entity::isDestroyed() const
 {
-	return mHitpoints <= 0;
+	return mStore.mHitpoints[mStoreIndex] <= 0;
+}
+
+void Entity::steer(sf::Time)
+{
+	// 默认保持当前速度，位移由 EntityStore::integrate 统一计算
+}
+
+HitShape Entity::getHitShape() const
+{
+	return makeHitShape(getWorldTransform(), getHitBox());
+}
+
+sf::FloatRect Entity::getHitBounds() const
+{
+	return getBounds(getHitShape());
+}
+
+PlacedMask Entity::getPlacedMask(const CollisionMaskAtlas& masks) const
+{
+	// 像素行只能在朝上或旋转 180 度时直接对齐，转向中的导弹不使用遮罩
+	sf::Transform transform = getWorldTransform();
+	sf::Vector2f axis = transform.transformPoint(1.f, 0.f) - transform.transformPoint(0.f, 0.f);
+	PlacedMask placed = {nullptr, sf::Vector2i()};
+	if (std::abs(axis.y) > 0.01f)
+		return placed;
+	// 精灵以中心为原点，两种朝向下世界包围盒的左上角都是遮罩的左上角
+	sf::FloatRect bounds = getBoundingRect();
+	placed.mask = masks.find(getTextureRect(), axis.x < 0.f);
+	placed.position.x = static_cast<int>(std::floor(bounds.left + 0.5f));
+	placed.position.y = static_cast<int>(std::floor(bounds.top + 0.5f));
+	return placed;
 }
 
-void Entity::updateCurrent(sf::Time dt, CommandQueue&)
+EntityStore& Entity::getStore() const
 {
-	move(mVelocity * dt.asSeconds());
+	return mStore;
 }
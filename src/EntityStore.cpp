@@ -0,0 +1,217 @@
+#include <Book/EntityStore.hpp>
+#include <Book/Entity.hpp>
+#include <Book/JobSystem.hpp>
+#include <Book/CollisionDispatcher.hpp>
+#include <Book/Foreach.hpp>
+#include <Book/Utility.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	const std::size_t EntityGrainSize = 64;
+}
+
+EntityStore::EntityStore()
+: mOwners()
+, mVelocities()
+, mHitpoints()
+, mCategories()
+, mColliders()
+, mHitShapes()
+, mMasks()
+, mDisplacements()
+, mPendingRemoval()
+, mWrecks()
+, mWreckParents()
+, mSweptBounds()
+, mSweepOrder()
+{
+}
+
+void EntityStore::steer(sf::Time dt, JobSystem& jobs)
+{
+	// 飞行路线和导弹制导只修改各自的速度，可以并行
+	jobs.parallelFor(mOwners.size(), EntityGrainSize, [this, dt] (std::size_t begin, std::size_t end)
+	{
+		for (std::size_t i = begin; i < end; ++i)
+			mOwners[i]->steer(dt);
+	});
+}
+
+void EntityStore::integrate(sf::Time dt, JobSystem& jobs)
+{
+	// 连续读取速度和生命值，只把位移写回场景节点；已被摧毁的实体停在原地
+	// 位移保留到下一次碰撞检测，用于扫掠测试
+	float seconds = dt.asSeconds();
+	jobs.parallelFor(mOwners.size(), EntityGrainSize, [this, seconds] (std::size_t begin, std::size_t end)
+	{
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			mDisplacements[i] = (mHitpoints[i] > 0) ? mVelocities[i] * seconds : sf::Vector2f();
+			mOwners[i]->move(mDisplacements[i]);
+		}
+	});
+}
+
+void EntityStore::updateColliders(const CollisionMaskAtlas& masks)
+{
+	// 每步计算一次世界坐标下的有向碰撞框、包围盒和遮罩位置，类别在实体构造完成后第一次更新时记录
+	for (std::size_t i = 0; i < mOwners.size(); ++i)
+	{
+		if (mCategories[i] == Category::None)
+			mCategories[i] = mOwners[i]->getCategory();
+		mHitShapes[i] = mOwners[i]->getHitShape();
+		mColliders[i] = getBounds(mHitShapes[i]);
+		mMasks[i] = mOwners[i]->getPlacedMask(masks);
+	}
+	// 扫掠包围盒覆盖这一步起点和终点的碰撞框，两个实体的相对扫掠相交时它们的扫掠包围盒一定相交
+	mSweptBounds.resize(mOwners.size());
+	mSweepOrder.resize(mOwners.size());
+	for (std::size_t i = 0; i < mOwners.size(); ++i)
+	{
+		const sf::FloatRect& end = mColliders[i];
+		float left = std::min(end.left, end.left - mDisplacements[i].x);
+		float top = std::min(end.top, end.top - mDisplacements[i].y);
+		mSweptBounds[i] = sf::FloatRect(left, top, end.width + std::abs(mDisplacements[i].x), end.height + std::abs(mDisplacements[i].y));
+		mSweepOrder[i] = i;
+	}
+	std::sort(mSweepOrder.begin(), mSweepOrder.end(), [this] (std::size_t lhs, std::size_t rhs)
+	{
+		return mSweptBounds[lhs].top < mSweptBounds[rhs].top;
+	});
+}
+
+void EntityStore::checkCollisions(const CollisionDispatcher& collisions, std::vector<Contact>& contacts,
+	CollisionStatistics& statistics) const
+{
+	// 沿排序后的扫掠包围盒向下扫描，后面的包围盒上边越过当前下边时停止
+	// 每个组合只在排序靠前的一方访问一次，按下标较小的一方作为第一个实体，与逐对检查的结果相同
+	statistics.tests = 0;
+	statistics.candidates = 0;
+	statistics.maskTests = 0;
+	for (std::size_t a = 0; a < mSweepOrder.size(); ++a)
+	{
+		std::size_t first = mSweepOrder[a];
+		if (mHitpoints[first] <= 0)
+			continue;
+		float bottom = mSweptBounds[first].top + mSweptBounds[first].height;
+		for (std::size_t b = a + 1; b < mSweepOrder.size() && mSweptBounds[mSweepOrder[b]].top <= bottom; ++b)
+		{
+			std::size_t i = std::min(first, mSweepOrder[b]);
+			std::size_t j = std::max(first, mSweepOrder[b]);
+			// 先按碰撞矩阵过滤类别，没有响应的组合不做相交测试
+			if (!(collisions.getCollisionMask(mCategories[i]) & mCategories[j]) || mHitpoints[j] <= 0 || mHitpoints[i] <= 0)
+				continue;
+			// 宽阶段：按上一步的相对位移对包围盒做扫掠测试，快速的导弹不会穿过目标
+			++statistics.tests;
+			if (!sweptIntersects(mColliders[i], mDisplacements[i] - mDisplacements[j], mColliders[j]))
+				continue;
+			// 窄阶段：结束位置的包围盒仍然相交时先用有向碰撞框做分离轴测试，
+			// 再比较两者的像素遮罩；否则是在这一步中途穿过，直接采用扫掠结果
+			++statistics.candidates;
+			if (mColliders[i].intersects(mColliders[j]))
+			{
+				if (!intersects(mHitShapes[i], mHitShapes[j]))
+					continue;
+				++statistics.maskTests;
+				if (!overlaps(mMasks[i], mMasks[j]))
+					continue;
+			}
+			Contact contact = {mOwners[i], mOwners[j], mCategories[i], mCategories[j]};
+			contacts.push_back(contact);
+		}
+	}
+}
+
+void EntityStore::removeWrecks()
+{
+	// 爆炸还没播放完的飞机留在列表中等下一步，被修复的实体直接移出列表
+	// 摘下的节点先在父节点中留下空位，最后每个父节点保持顺序地压缩一次
+	std::size_t count = 0;
+	for (std::size_t i = 0; i < mWrecks.size(); ++i)
+	{
+		Entity* wreck = mWrecks[i];
+		if (wreck->isMarkedForRemoval())
+		{
+			// 摘下的节点在这里析构，同时从组件数组中删除
+			SceneNode* parent = wreck->getParent();
+			if (std::find(mWreckParents.begin(), mWreckParents.end(), parent) == mWreckParents.end())
+				mWreckParents.push_back(parent);
+			SceneNode::Ptr node = parent->releaseChild(*wreck);
+		}
+		else if (!wreck->isDestroyed())
+		{
+			mPendingRemoval[wreck->mStoreIndex] = 0;
+		}
+		else
+		{
+			mWrecks[count++] = wreck;
+		}
+	}
+	mWrecks.resize(count);
+	FOREACH(SceneNode* parent, mWreckParents)
+		parent->compactChildren();
+	mWreckParents.clear();
+}
+
+std::size_t EntityStore::getEntityCount() const
+{
+	return mOwners.size();
+}
+
+Entity* EntityStore::getEntity(std::size_t index) const
+{
+	return mOwners[index];
+}
+
+std::size_t EntityStore::insert(Entity& owner, int hitpoints)
+{
+	mOwners.push_back(&owner);
+	mVelocities.push_back(sf::Vector2f());
+	mHitpoints.push_back(hitpoints);
+	mCategories.push_back(Category::None);
+	mColliders.push_back(sf::FloatRect());
+	mHitShapes.push_back(HitShape());
+	mMasks.push_back(PlacedMask());
+	mDisplacements.push_back(sf::Vector2f());
+	mPendingRemoval.push_back(0);
+	return mOwners.size() - 1;
+}
+
+void EntityStore::erase(std::size_t index)
+{
+	// 用最后一个实体填补空位，并更新它的下标
+	std::size_t last = mOwners.size() - 1;
+	if (index != last)
+	{
+		mOwners[index] = mOwners[last];
+		mVelocities[index] = mVelocities[last];
+		mHitpoints[index] = mHitpoints[last];
+		mCategories[index] = mCategories[last];
+		mColliders[index] = mColliders[last];
+		mHitShapes[index] = mHitShapes[last];
+		mMasks[index] = mMasks[last];
+		mDisplacements[index] = mDisplacements[last];
+		mPendingRemoval[index] = mPendingRemoval[last];
+		mOwners[index]->mStoreIndex = index;
+	}
+	mOwners.pop_back();
+	mVelocities.pop_back();
+	mHitpoints.pop_back();
+	mCategories.pop_back();
+	mColliders.pop_back();
+	mHitShapes.pop_back();
+	mMasks.pop_back();
+	mDisplacements.pop_back();
+	mPendingRemoval.pop_back();
+}
+
+void EntityStore::addWreck(std::size_t index)
+{
+	if (!mPendingRemoval[index])
+	{
+		mPendingRemoval[index] = 1;
+		mWrecks.push_back(mOwners[index]);
+	}
+}
@@ -0,0 +1,119 @@
+#include <Book/FrameBudgetMonitor.hpp>
+#include <Book/Foreach.hpp>
+#include <fstream>
+
+namespace
+{
+	float toMilliseconds(sf::Time time)
+	{
+		return time.asMicroseconds() / 1000.f;
+	}
+}
+
+FrameBudgetMonitor::FrameBudgetMonitor(sf::Time budget, std::size_t maxRecords)
+: mBudget(budget)
+, mMaxRecords(maxRecords)
+, mFrameCount(0)
+, mUnrecordedOverruns(0)
+, mTotalDroppedTime(sf::Time::Zero)
+, mCurrent()
+, mLastFrame()
+, mCurrentPhase(PhaseCount)
+, mPhaseClock()
+, mOverruns()
+{
+}
+
+void FrameBudgetMonitor::beginFrame()
+{
+	mCurrent = Record();
+	mCurrent.frame = mFrameCount;
+	mCurrent.updateSteps = 0;
+	mCurrentPhase = PhaseCount;
+}
+
+void FrameBudgetMonitor::beginPhase(Phase phase)
+{
+	endPhase();
+	mCurrentPhase = phase;
+	mPhaseClock.restart();
+}
+
+void FrameBudgetMonitor::endPhase()
+{
+	// 同一阶段在一帧内可以多次出现（例如多次追赶更新），时间累加
+	if (mCurrentPhase != PhaseCount)
+		mCurrent.phases[mCurrentPhase] += mPhaseClock.getElapsedTime();
+	mCurrentPhase = PhaseCount;
+}
+
+void FrameBudgetMonitor::addUpdateStep()
+{
+	++mCurrent.updateSteps;
+}
+
+void FrameBudgetMonitor::addDroppedTime(sf::Time time)
+{
+	mCurrent.droppedTime += time;
+	mTotalDroppedTime += time;
+}
+
+void FrameBudgetMonitor::endFrame()
+{
+	endPhase();
+	// 等待垂直同步的Present阶段不计入预算
+	mCurrent.workTime = mCurrent.phases[Input] + mCurrent.phases[Update] + mCurrent.phases[Render];
+	if (mCurrent.workTime > mBudget || mCurrent.droppedTime > sf::Time::Zero)
+	{
+		if (mOverruns.size() < mMaxRecords)
+			mOverruns.push_back(mCurrent);
+		else
+			++mUnrecordedOverruns;
+	}
+	mLastFrame = mCurrent;
+	++mFrameCount;
+}
+
+const FrameBudgetMonitor::Record& FrameBudgetMonitor::getLastFrame() const
+{
+	return mLastFrame;
+}
+
+const std::vector<FrameBudgetMonitor::Record>& FrameBudgetMonitor::getOverruns() const
+{
+	return mOverruns;
+}
+
+std::size_t FrameBudgetMonitor::getFrameCount() const
+{
+	return mFrameCount;
+}
+
+sf::Time FrameBudgetMonitor::getTotalDroppedTime() const
+{
+	return mTotalDroppedTime;
+}
+
+bool FrameBudgetMonitor::writeReport(const std::string& filename) const
+{
+	std::ofstream file(filename.c_str());
+	if (!file)
+		return false;
+	file << "# budget_ms " << toMilliseconds(mBudget)
+		 << ", frames " << mFrameCount
+		 << ", overruns " << mOverruns.size() + mUnrecordedOverruns
+		 << ", dropped_ms " << toMilliseconds(mTotalDroppedTime) << "\n";
+	file << "frame,work_ms,input_ms,update_ms,render_ms,present_ms,update_steps,dropped_ms\n";
+	FOREACH(const Record& record, mOverruns)
+	{
+		file << record.frame << ","
+			 << toMilliseconds(record.workTime) << ","
+			 << toMilliseconds(record.phases[Input]) << ","
+			 << toMilliseconds(record.phases[Update]) << ","
+			 << toMilliseconds(record.phases[Render]) << ","
+			 << toMilliseconds(record.phases[Present]) << ","
+			 << record.updateSteps << ","
+			 << toMilliseconds(record.droppedTime) << "\n";
+	}
+	return true;
+}
@@ -0,0 +1,40 @@
+#include <Book/FrameLimiter.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <thread>
+
+FrameLimiter::FrameLimiter(unsigned int framerate, sf::Time spinThreshold)
+: mClock()
+, mFrameTime(sf::Time::Zero)
+, mSpinThreshold(spinThreshold)
+, mNextFrame(sf::Time::Zero)
+{
+	setFramerate(framerate);
+}
+
+void FrameLimiter::setFramerate(unsigned int framerate)
+{
+	// 0 表示不限制帧率
+	mFrameTime = (framerate > 0) ? sf::seconds(1.f / framerate) : sf::Time::Zero;
+	mNextFrame = mClock.getElapsedTime();
+}
+
+void FrameLimiter::wait()
+{
+	if (mFrameTime == sf::Time::Zero)
+		return;
+	mNextFrame += mFrameTime;
+	sf::Time now = mClock.getElapsedTime();
+	if (now >= mNextFrame)
+	{
+		// 落后超过一帧时重新对齐，避免之后连续多帧不等待
+		if (now - mNextFrame > mFrameTime)
+			mNextFrame = now;
+		return;
+	}
+	// 先交给系统睡眠，最后一小段自旋等待以保证精度
+	sf::Time remaining = mNextFrame - now;
+	if (remaining > mSpinThreshold)
+		sf::sleep(remaining - mSpinThreshold);
+	while (mClock.getElapsedTime() < mNextFrame)
+		std::this_thread::yield();
+}
@@ -2,6 +2,7 @@
 #include <Book/Utility.hpp>
 #include <Book/Player.hpp>
 #include <Book/ResourceHolder.hpp>
+#include <Book/RenderSnapshot.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/View.hpp>
@@ -23,7 +24,7 @@ GameOverState::GameOverState(StateStack& stack, Context context)
 	mGameOverText.setPosition(0.5f * windowSize.x, 0.4f * windowSize.y);
 }
 
-void GameOverState::draw()
+void GameOverState::draw(float)
 {
 	sf::RenderWindow& window = *getContext().window;
 	window.setView(window.getDefaultView());
@@ -35,6 +36,16 @@ void GameOverState::draw()
 	window.draw(mGameOverText);
 }
 
+void GameOverState::snapshot(RenderSnapshot& snapshot, float)
+{
+	sf::RenderWindow& window = *getContext().window;
+	sf::RectangleShape backgroundShape;
+	backgroundShape.setFillColor(sf::Color(0, 0, 0, 150));
+	backgroundShape.setSize(window.getDefaultView().getSize());
+	snapshot.addToOverlay(backgroundShape);
+	snapshot.addToOverlay(mGameOverText);
+}
+
 bool GameOverState::update(sf::Time dt)
 {
 	// ʾ3֮Զ˵
@@ -51,3 +62,8 @@ bool GameOverState::handleEvent(const sf::Event&)
 {
 	return false;
 }
+
+bool GameOverState::freezesStatesBelow() const
+{
+	return true;
+}
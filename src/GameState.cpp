@@ -1,10 +1,13 @@
 #include <Book/GameState.hpp>
 #include <Book/MusicPlayer.hpp>
+#include <Book/CollisionStatistics.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <ctime>
 
 GameState::GameState(StateStack& stack, Context context)
 : State(stack, context)
-, mWorld(*context.window, *context.fonts, *context.sounds)
+, mWorld(*context.window, *context.fonts, *context.sounds, *context.jobs, *context.graphics,
+	*context.renderTargets, (context.seed != 0) ? context.seed : static_cast<sf::Uint64>(std::time(nullptr)))
 , mPlayer(*context.player)
 {
 	mPlayer.setMissionStatus(Player::MissionRunning);
@@ -12,14 +15,27 @@ GameState::GameState(StateStack& stack, Context context)
 	context.music->play(Music::MissionTheme);
 }
 
-void GameState::draw()
+GameState::~GameState()
 {
-	mWorld.draw();
+	// 뿪ϷͳϢʾһֵײ
+	*getContext().collisions = CollisionStatistics();
+}
+
+void GameState::draw(float interpolation)
+{
+	mWorld.draw(interpolation);
+}
+
+void GameState::snapshot(RenderSnapshot& snapshot, float interpolation)
+{
+	mWorld.snapshot(snapshot, interpolation);
 }
 
 bool GameState::update(sf::Time dt)
 {
 	mWorld.update(dt);
+	// ײͳд Application еĽṹʾͳϢ
+	*getContext().collisions = mWorld.getCollisionStatistics();
 	if (!mWorld.hasAlivePlayer())
 	{
 		mPlayer.setMissionStatus(Player::MissionFailure);
@@ -35,6 +51,18 @@ bool GameState::update(sf::Time dt)
 	return true;
 }
 
+bool GameState::isOpaque() const
+{
+	// Ϸ
+	return true;
+}
+
+bool GameState::isAnimated() const
+{
+	// ²֮ҲҪֵ»ƣֻԸƵʱ仯
+	return true;
+}
+
 bool GameState::handleEvent(const sf::Event& event)
 {
 	// Ϸ봦
@@ -0,0 +1,165 @@
+#include <Book/GraphicsSettings.hpp>
+#include <algorithm>
+
+GraphicsSettings::GraphicsSettings()
+: mBloomQuality(BloomEffect::High)
+, mBloomDevice(AutomaticDevice)
+, mBloomUpdateInterval(1)
+, mBloomHistoryWeight(0.5f)
+, mBloomStatistics()
+, mDynamicResolution(false)
+, mResolutionScale(1.f)
+, mVerticalSync(true)
+, mFramerateLimit(60)
+, mMaxUpdatesPerFrame(5)
+, mStatisticsVisible(false)
+, mRenderThread(false)
+{
+}
+
+void GraphicsSettings::setBloomQuality(BloomEffect::Quality quality)
+{
+	mBloomQuality = quality;
+}
+
+BloomEffect::Quality GraphicsSettings::getBloomQuality() const
+{
+	return mBloomQuality;
+}
+
+void GraphicsSettings::setBloomDevice(BloomDevice device)
+{
+	mBloomDevice = device;
+}
+
+GraphicsSettings::BloomDevice GraphicsSettings::getBloomDevice() const
+{
+	return mBloomDevice;
+}
+
+bool GraphicsSettings::usesCpuBloom() const
+{
+	// 自动模式下没有着色器时才使用CPU实现
+	switch (mBloomDevice)
+	{
+		case GpuDevice:	return false;
+		case CpuDevice:	return true;
+		default:		return !PostEffect::isSupported();
+	}
+}
+
+void GraphicsSettings::setBloomUpdateInterval(unsigned int frames)
+{
+	mBloomUpdateInterval = std::max(frames, 1u);
+}
+
+unsigned int GraphicsSettings::getBloomUpdateInterval() const
+{
+	return mBloomUpdateInterval;
+}
+
+void GraphicsSettings::setBloomHistoryWeight(float weight)
+{
+	// 权重越大画面越稳定，但亮部变化的拖影也越明显
+	mBloomHistoryWeight = std::max(0.f, std::min(weight, 0.95f));
+}
+
+float GraphicsSettings::getBloomHistoryWeight() const
+{
+	return mBloomHistoryWeight;
+}
+
+const char* GraphicsSettings::getBloomDeviceName(BloomDevice device)
+{
+	switch (device)
+	{
+		case AutomaticDevice:	return "Auto";
+		case GpuDevice:			return "GPU";
+		case CpuDevice:			return "CPU";
+		default:				return "";
+	}
+}
+
+void GraphicsSettings::setBloomStatistics(const BloomEffect::Statistics& statistics)
+{
+	mBloomStatistics = statistics;
+}
+
+const BloomEffect::Statistics& GraphicsSettings::getBloomStatistics() const
+{
+	return mBloomStatistics;
+}
+
+void GraphicsSettings::setDynamicResolutionEnabled(bool flag)
+{
+	mDynamicResolution = flag;
+	if (!flag)
+		mResolutionScale = 1.f;
+}
+
+bool GraphicsSettings::isDynamicResolutionEnabled() const
+{
+	return mDynamicResolution;
+}
+
+void GraphicsSettings::setResolutionScale(float scale)
+{
+	mResolutionScale = scale;
+}
+
+float GraphicsSettings::getResolutionScale() const
+{
+	return mResolutionScale;
+}
+
+void GraphicsSettings::setVerticalSyncEnabled(bool flag)
+{
+	mVerticalSync = flag;
+}
+
+bool GraphicsSettings::isVerticalSyncEnabled() const
+{
+	return mVerticalSync;
+}
+
+void GraphicsSettings::setFramerateLimit(unsigned int framerate)
+{
+	// 0 表示不限制；开启垂直同步时不使用
+	mFramerateLimit = framerate;
+}
+
+unsigned int GraphicsSettings::getFramerateLimit() const
+{
+	return mFramerateLimit;
+}
+
+void GraphicsSettings::setMaxUpdatesPerFrame(std::size_t steps)
+{
+	// 卡顿后每帧最多追赶的更新步数，至少一步
+	mMaxUpdatesPerFrame = std::max<std::size_t>(steps, 1);
+}
+
+std::size_t GraphicsSettings::getMaxUpdatesPerFrame() const
+{
+	return mMaxUpdatesPerFrame;
+}
+
+void GraphicsSettings::setStatisticsVisible(bool flag)
+{
+	mStatisticsVisible = flag;
+}
+
+bool GraphicsSettings::isStatisticsVisible() const
+{
+	return mStatisticsVisible;
+}
+
+void GraphicsSettings::setRenderThreadEnabled(bool flag)
+{
+	mRenderThread = flag;
+}
+
+bool GraphicsSettings::isRenderThreadEnabled() const
+{
+	return mRenderThread;
+}
@@ -0,0 +1,63 @@
+#include <Book/HitShape.hpp>
+#include <algorithm>
+
+namespace
+{
+	// 两个碰撞框在 (axisX, axisY) 上的投影区间是否分离
+	bool separatedOnAxis(const HitShape& lhs, const HitShape& rhs, float axisX, float axisY)
+	{
+		float lhsProjection[4];
+		float rhsProjection[4];
+		for (int i = 0; i < 4; ++i)
+		{
+			lhsProjection[i] = lhs.x[i] * axisX + lhs.y[i] * axisY;
+			rhsProjection[i] = rhs.x[i] * axisX + rhs.y[i] * axisY;
+		}
+		float lhsMin = std::min(std::min(lhsProjection[0], lhsProjection[1]), std::min(lhsProjection[2], lhsProjection[3]));
+		float lhsMax = std::max(std::max(lhsProjection[0], lhsProjection[1]), std::max(lhsProjection[2], lhsProjection[3]));
+		float rhsMin = std::min(std::min(rhsProjection[0], rhsProjection[1]), std::min(rhsProjection[2], rhsProjection[3]));
+		float rhsMax = std::max(std::max(rhsProjection[0], rhsProjection[1]), std::max(rhsProjection[2], rhsProjection[3]));
+		return lhsMax <= rhsMin || rhsMax <= lhsMin;
+	}
+
+	bool separatedOnEdges(const HitShape& shape, const HitShape& lhs, const HitShape& rhs)
+	{
+		// 矩形只有两个方向不同的边，法线方向不需要归一化
+		return separatedOnAxis(lhs, rhs, shape.y[0] - shape.y[1], shape.x[1] - shape.x[0])
+			|| separatedOnAxis(lhs, rhs, shape.y[1] - shape.y[2], shape.x[2] - shape.x[1]);
+	}
+}
+
+HitShape makeHitShape(const sf::Transform& transform, const sf::FloatRect& localRect)
+{
+	const sf::Vector2f corners[4] =
+	{
+		sf::Vector2f(localRect.left, localRect.top),
+		sf::Vector2f(localRect.left + localRect.width, localRect.top),
+		sf::Vector2f(localRect.left + localRect.width, localRect.top + localRect.height),
+		sf::Vector2f(localRect.left, localRect.top + localRect.height),
+	};
+	HitShape shape;
+	for (int i = 0; i < 4; ++i)
+	{
+		sf::Vector2f point = transform.transformPoint(corners[i]);
+		shape.x[i] = point.x;
+		shape.y[i] = point.y;
+	}
+	return shape;
+}
+
+sf::FloatRect getBounds(const HitShape& shape)
+{
+	float left = std::min(std::min(shape.x[0], shape.x[1]), std::min(shape.x[2], shape.x[3]));
+	float right = std::max(std::max(shape.x[0], shape.x[1]), std::max(shape.x[2], shape.x[3]));
+	float top = std::min(std::min(shape.y[0], shape.y[1]), std::min(shape.y[2], shape.y[3]));
+	float bottom = std::max(std::max(shape.y[0], shape.y[1]), std::max(shape.y[2], shape.y[3]));
+	return sf::FloatRect(left, top, right - left, bottom - top);
+}
+
+bool intersects(const HitShape& lhs, const HitShape& rhs)
+{
+	// 分离轴测试：两个矩形共四个边法线，任一方向上投影分离即不相交
+	return !separatedOnEdges(lhs, lhs, rhs) && !separatedOnEdges(rhs, lhs, rhs);
+}
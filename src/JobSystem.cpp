@@ -0,0 +1,184 @@
+#include <Book/JobSystem.hpp>
+#include <Book/Foreach.hpp>
+#include <algorithm>
+#include <cassert>
+
+const std::size_t JobSystem::MaxCallerThreads = 4;
+
+JobSystem::JobSystem(std::size_t threadCount)
+: mQueues()
+, mWorkers()
+, mCallerMutex()
+, mCallerQueues()
+, mWakeMutex()
+, mWakeCondition()
+, mQueuedJobs(0)
+, mShutdown(false)
+{
+	// 0 表示按硬件线程数创建，调用线程本身也算一个
+	// 前 threadCount - 1 个队列属于工作线程，之后的队列留给外部调用线程
+	if (threadCount == 0)
+		threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+	for (std::size_t i = 0; i < threadCount - 1 + MaxCallerThreads; ++i)
+		mQueues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+	for (std::size_t i = 0; i + 1 < threadCount; ++i)
+		mWorkers.push_back(std::thread(&JobSystem::workerLoop, this, i));
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(mWakeMutex);
+		mShutdown = true;
+	}
+	mWakeCondition.notify_all();
+	FOREACH(std::thread& worker, mWorkers)
+		worker.join();
+}
+
+void JobSystem::parallelFor(std::size_t count, std::size_t grainSize, const RangeJob& job)
+{
+	assert(!isWorkerThread());
+	if (count == 0)
+		return;
+	grainSize = std::max<std::size_t>(grainSize, 1);
+	std::size_t chunkCount = (count + grainSize - 1) / grainSize;
+	// 单线程、只有一个区间或调用线程的队列已经分完时直接在调用线程执行
+	std::size_t callerQueue = 0;
+	if (mWorkers.empty() || chunkCount == 1 || !acquireCallerQueue(callerQueue))
+	{
+		job(0, count);
+		return;
+	}
+	// 将区间轮流分配到各工作线程和调用线程自己的队列，空闲线程会从别的队列窃取
+	std::size_t queueCount = mWorkers.size() + 1;
+	std::atomic<std::size_t> remaining(chunkCount);
+	for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+	{
+		std::size_t begin = chunk * grainSize;
+		std::size_t end = std::min(begin + grainSize, count);
+		std::size_t queue = chunk % queueCount;
+		push(queue < mWorkers.size() ? queue : callerQueue, [&job, &remaining, begin, end] ()
+		{
+			job(begin, end);
+			--remaining;
+		});
+	}
+	{
+		std::lock_guard<std::mutex> lock(mWakeMutex);
+	}
+	mWakeCondition.notify_all();
+	// 调用线程也参与执行，直到本批区间全部完成；窃取到其他调用线程的区间也照常执行
+	Job next;
+	while (remaining > 0)
+	{
+		if (pop(callerQueue, next) || steal(callerQueue, next))
+			next();
+		else
+			std::this_thread::yield();
+	}
+}
+
+void JobSystem::unregisterCaller()
+{
+	// 调用线程的区间在 parallelFor 返回前都已执行完，归还时队列是空的
+	std::lock_guard<std::mutex> lock(mCallerMutex);
+	mCallerQueues.erase(std::this_thread::get_id());
+}
+
+std::size_t JobSystem::getThreadCount() const
+{
+	return mWorkers.size() + 1;
+}
+
+void JobSystem::push(std::size_t queueIndex, Job job)
+{
+	WorkQueue& queue = *mQueues[queueIndex];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	queue.jobs.push_back(std::move(job));
+	++mQueuedJobs;
+}
+
+bool JobSystem::pop(std::size_t queueIndex, Job& job)
+{
+	// 自己的队列从尾部取，保持缓存局部性
+	WorkQueue& queue = *mQueues[queueIndex];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	if (queue.jobs.empty())
+		return false;
+	job = std::move(queue.jobs.back());
+	queue.jobs.pop_back();
+	--mQueuedJobs;
+	return true;
+}
+
+bool JobSystem::steal(std::size_t thiefIndex, Job& job)
+{
+	// 从其他线程队列的头部窃取
+	for (std::size_t offset = 1; offset < mQueues.size(); ++offset)
+	{
+		WorkQueue& queue = *mQueues[(thiefIndex + offset) % mQueues.size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.jobs.empty())
+			continue;
+		job = std::move(queue.jobs.front());
+		queue.jobs.pop_front();
+		--mQueuedJobs;
+		return true;
+	}
+	return false;
+}
+
+bool JobSystem::acquireCallerQueue(std::size_t& queueIndex)
+{
+	// 外部线程第一次调用时分配一个空闲的专用队列，之后一直使用同一个，直到 unregisterCaller
+	std::lock_guard<std::mutex> lock(mCallerMutex);
+	std::thread::id caller = std::this_thread::get_id();
+	auto found = mCallerQueues.find(caller);
+	if (found != mCallerQueues.end())
+	{
+		queueIndex = found->second;
+		return true;
+	}
+	for (std::size_t queue = mWorkers.size(); queue < mWorkers.size() + MaxCallerThreads; ++queue)
+	{
+		bool used = false;
+		for (auto entry = mCallerQueues.begin(); entry != mCallerQueues.end() && !used; ++entry)
+			used = (entry->second == queue);
+		if (!used)
+		{
+			mCallerQueues.insert(std::make_pair(caller, queue));
+			queueIndex = queue;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool JobSystem::isWorkerThread() const
+{
+	std::thread::id current = std::this_thread::get_id();
+	FOREACH(const std::thread& worker, mWorkers)
+	{
+		if (worker.get_id() == current)
+			return true;
+	}
+	return false;
+}
+
+void JobSystem::workerLoop(std::size_t queueIndex)
+{
+	Job job;
+	for (;;)
+	{
+		if (pop(queueIndex, job) || steal(queueIndex, job))
+		{
+			job();
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(mWakeMutex);
+		mWakeCondition.wait(lock, [this] () { return mShutdown || mQueuedJobs > 0; });
+		if (mShutdown)
+			return;
+	}
+}
@@ -1,5 +1,6 @@
 #include <Book/Label.hpp>
 #include <Book/Utility.hpp>
+#include <Book/RenderSnapshot.hpp>
 #include <SFML/Graphics/RenderStates.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 
@@ -26,6 +27,12 @@ void Label::draw(sf::RenderTarget& target, sf::RenderStates states) const
 	target.draw(mText, states);
 }
 
+void Label::snapshot(RenderSnapshot& snapshot, sf::RenderStates states) const
+{
+	states.transform *= getTransform();
+	snapshot.addToOverlay(mText, states);
+}
+
 void Label::setText(const std::string& text)
 {
 	mText.setString(text);
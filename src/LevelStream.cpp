@@ -0,0 +1,226 @@
+#include <Book/LevelStream.hpp>
+#include <Book/Aircraft.hpp>
+#include <Book/Foreach.hpp>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+	const char			Magic[4] = {'S', 'L', 'V', 'L'};
+	const sf::Uint32	Version = 2;
+	const std::size_t	HeaderSize = 20;
+	const std::size_t	VersionOneHeaderSize = 16;
+	const std::size_t	RecordSize = 16;
+	// 版本1文件和内置关卡的长度
+	const float			DefaultLevelLength = 5000.f;
+	// 每次从文件读入的事件数
+	const std::size_t	BlockEvents = 256;
+
+	sf::Uint32 readUint32(const char* p)
+	{
+		const unsigned char* b = reinterpret_cast<const unsigned char*>(p);
+		return b[0] | (b[1] << 8) | (b[2] << 16) | (static_cast<sf::Uint32>(b[3]) << 24);
+	}
+
+	float readFloat(const char* p)
+	{
+		sf::Uint32 bits = readUint32(p);
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	void writeUint32(char* p, sf::Uint32 value)
+	{
+		for (int i = 0; i < 4; ++i)
+			p[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+	}
+
+	void writeFloat(char* p, float value)
+	{
+		sf::Uint32 bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		writeUint32(p, bits);
+	}
+
+	bool compareDistance(const LevelEvent& lhs, const LevelEvent& rhs)
+	{
+		return lhs.distance < rhs.distance;
+	}
+
+	LevelEvent makeEnemy(Aircraft::Type type, float x, float distance)
+	{
+		LevelEvent event = {distance, x, 0.f, LevelEvent::SpawnEnemy, static_cast<sf::Uint8>(type), 1};
+		return event;
+	}
+}
+
+LevelStream::LevelStream(const std::string& filename)
+: mFile(filename.c_str(), std::ios::binary)
+, mBuffer()
+, mBufferPosition(0)
+, mUnreadEvents(0)
+, mEventCount(0)
+, mScrollSpeed(-50.f)
+, mLevelLength(DefaultLevelLength)
+, mLastDistance(-std::numeric_limits<float>::max())
+{
+	if (readHeader())
+		fillBuffer();
+	else
+		loadDefaultLevel();
+}
+
+bool LevelStream::hasPendingEvent() const
+{
+	return mBufferPosition < mBuffer.size();
+}
+
+const LevelEvent& LevelStream::peekEvent() const
+{
+	return mBuffer[mBufferPosition];
+}
+
+void LevelStream::popEvent()
+{
+	if (++mBufferPosition == mBuffer.size())
+		fillBuffer();
+}
+
+float LevelStream::getScrollSpeed() const
+{
+	return mScrollSpeed;
+}
+
+float LevelStream::getLevelLength() const
+{
+	return mLevelLength;
+}
+
+std::size_t LevelStream::getEventCount() const
+{
+	return mEventCount;
+}
+
+bool LevelStream::writeToFile(const std::string& filename, float scrollSpeed, float levelLength,
+	std::vector<LevelEvent> events)
+{
+	// 写入前按触发距离排序，读取时只需顺序前进
+	std::stable_sort(events.begin(), events.end(), compareDistance);
+	std::ofstream file(filename.c_str(), std::ios::binary);
+	char header[HeaderSize];
+	std::memcpy(header, Magic, sizeof(Magic));
+	writeUint32(header + 4, Version);
+	writeUint32(header + 8, static_cast<sf::Uint32>(events.size()));
+	writeFloat(header + 12, scrollSpeed);
+	writeFloat(header + 16, levelLength);
+	file.write(header, HeaderSize);
+	FOREACH(const LevelEvent& event, events)
+	{
+		char record[RecordSize];
+		writeFloat(record, event.distance);
+		writeFloat(record + 4, event.x);
+		writeFloat(record + 8, event.value);
+		record[12] = static_cast<char>(event.type);
+		record[13] = static_cast<char>(event.subtype);
+		record[14] = static_cast<char>(event.count & 0xff);
+		record[15] = static_cast<char>(event.count >> 8);
+		file.write(record, RecordSize);
+	}
+	return static_cast<bool>(file);
+}
+
+bool LevelStream::readHeader()
+{
+	char header[HeaderSize];
+	if (!mFile.read(header, VersionOneHeaderSize) || std::memcmp(header, Magic, sizeof(Magic)) != 0)
+		return false;
+	sf::Uint32 version = readUint32(header + 4);
+	if (version == Version)
+	{
+		if (!mFile.read(header + VersionOneHeaderSize, HeaderSize - VersionOneHeaderSize))
+			return false;
+		mLevelLength = readFloat(header + 16);
+	}
+	else if (version != 1)
+	{
+		return false;
+	}
+	mEventCount = readUint32(header + 8);
+	mUnreadEvents = mEventCount;
+	mScrollSpeed = readFloat(header + 12);
+	return true;
+}
+
+void LevelStream::fillBuffer()
+{
+	// 复用缓冲区，一次读入一整块记录再解码
+	mBuffer.clear();
+	mBufferPosition = 0;
+	std::size_t count = std::min(mUnreadEvents, BlockEvents);
+	if (count == 0)
+		return;
+	char block[BlockEvents * RecordSize];
+	mFile.read(block, count * RecordSize);
+	count = static_cast<std::size_t>(mFile.gcount()) / RecordSize;
+	mUnreadEvents = (count == 0) ? 0 : mUnreadEvents - count;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const char* record = block + i * RecordSize;
+		LevelEvent event;
+		event.distance = readFloat(record);
+		event.x = readFloat(record + 4);
+		event.value = readFloat(record + 8);
+		event.type = static_cast<sf::Uint8>(record[12]);
+		event.subtype = static_cast<sf::Uint8>(record[13]);
+		event.count = static_cast<sf::Uint16>(static_cast<unsigned char>(record[14]) | (static_cast<unsigned char>(record[15]) << 8));
+		mBuffer.push_back(event);
+	}
+	// World 遇到第一个未到的事件就停止，文件应当有序；块内的乱序在这里排好，
+	// 比上一块更早的事件无法提前，推迟到上一块最后一个事件的距离触发
+	if (!std::is_sorted(mBuffer.begin(), mBuffer.end(), compareDistance))
+		std::stable_sort(mBuffer.begin(), mBuffer.end(), compareDistance);
+	FOREACH(LevelEvent& event, mBuffer)
+		event.distance = std::max(event.distance, mLastDistance);
+	if (!mBuffer.empty())
+		mLastDistance = mBuffer.back().distance;
+}
+
+void LevelStream::loadDefaultLevel()
+{
+	// 没有关卡文件时使用的内置关卡
+	const LevelEvent events[] =
+	{
+		makeEnemy(Aircraft::Raptor,    0.f,  500.f),
+		makeEnemy(Aircraft::Raptor,    0.f, 1000.f),
+		makeEnemy(Aircraft::Raptor, +100.f, 1150.f),
+		makeEnemy(Aircraft::Raptor, -100.f, 1150.f),
+		makeEnemy(Aircraft::Avenger,  70.f, 1500.f),
+		makeEnemy(Aircraft::Avenger, -70.f, 1500.f),
+		makeEnemy(Aircraft::Avenger,  70.f, 1700.f),
+		makeEnemy(Aircraft::Avenger, -70.f, 1710.f),
+		makeEnemy(Aircraft::Avenger,  30.f, 1850.f),
+		makeEnemy(Aircraft::Raptor,  300.f, 2200.f),
+		makeEnemy(Aircraft::Raptor, -300.f, 2200.f),
+		makeEnemy(Aircraft::Raptor,    0.f, 2200.f),
+		makeEnemy(Aircraft::Raptor,    0.f, 2500.f),
+		makeEnemy(Aircraft::Avenger,-300.f, 2700.f),
+		makeEnemy(Aircraft::Avenger,-300.f, 2700.f),
+		makeEnemy(Aircraft::Raptor,    0.f, 3000.f),
+		makeEnemy(Aircraft::Raptor,  250.f, 3250.f),
+		makeEnemy(Aircraft::Raptor, -250.f, 3250.f),
+		makeEnemy(Aircraft::Avenger,   0.f, 3500.f),
+		makeEnemy(Aircraft::Avenger,   0.f, 3700.f),
+		makeEnemy(Aircraft::Raptor,    0.f, 3800.f),
+		makeEnemy(Aircraft::Avenger,   0.f, 4000.f),
+		makeEnemy(Aircraft::Avenger,-200.f, 4200.f),
+		makeEnemy(Aircraft::Raptor,  200.f, 4200.f),
+		makeEnemy(Aircraft::Raptor,    0.f, 4400.f),
+	};
+	mBuffer.assign(std::begin(events), std::end(events));
+	mBufferPosition = 0;
+	mUnreadEvents = 0;
+	mEventCount = mBuffer.size();
+	mLevelLength = DefaultLevelLength;
+}
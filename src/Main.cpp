@@ -2,13 +2,25 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <cstring>
+#include <cstdlib>
 
 
-int main()
+int main(int argc, char* argv[])
 {
 	try
 	{
-		Application app;
+		// --seed <n> 固定关卡随机数种子，用于重现同一局；--max-updates <n> 设置每帧最多追赶的更新步数
+		sf::Uint64 seed = 0;
+		std::size_t maxUpdates = 0;
+		for (int i = 1; i + 1 < argc; ++i)
+		{
+			if (std::strcmp(argv[i], "--seed") == 0)
+				seed = std::strtoull(argv[i + 1], nullptr, 10);
+			else if (std::strcmp(argv[i], "--max-updates") == 0)
+				maxUpdates = std::strtoul(argv[i + 1], nullptr, 10);
+		}
+		Application app(seed, maxUpdates);
 		app.run();
 	}
 	catch (std::exception& error)
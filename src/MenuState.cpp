@@ -3,6 +3,7 @@
 #include <Book/Utility.hpp>
 #include <Book/MusicPlayer.hpp>
 #include <Book/ResourceHolder.hpp>
+#include <Book/RenderSnapshot.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/View.hpp>
 
@@ -41,7 +42,7 @@ MenuState::MenuState(StateStack& stack, Context context)
 	context.music->play(Music::MenuTheme);
 }
 
-void MenuState::draw()
+void MenuState::draw(float)
 {
 	sf::RenderWindow& window = *getContext().window;
 	window.setView(window.getDefaultView());
@@ -49,13 +50,25 @@ void MenuState::draw()
 	window.draw(mGUIContainer);
 }
 
+void MenuState::snapshot(RenderSnapshot& snapshot, float)
+{
+	snapshot.addToOverlay(mBackgroundSprite);
+	mGUIContainer.snapshot(snapshot, sf::RenderStates::Default);
+}
+
 bool MenuState::update(sf::Time)
 {
 	return true;
 }
 
+bool MenuState::isOpaque() const
+{
+	return true;
+}
+
 bool MenuState::handleEvent(const sf::Event& event)
 {
 	mGUIContainer.handleEvent(event);
+	requestRedraw();
 	return false;
 }
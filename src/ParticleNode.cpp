@@ -2,6 +2,8 @@
 #include <Book/Foreach.hpp>
 #include <Book/DataTables.hpp>
 #include <Book/ResourceHolder.hpp>
+#include <Book/JobSystem.hpp>
+#include <Book/RenderSnapshot.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <algorithm>
@@ -9,6 +11,7 @@
 namespace
 {
 	const std::vector<ParticleData> Table = initializeParticleData();
+	const std::size_t AgingGrainSize = 1024;
 }
 
 ParticleNode::ParticleNode(Particle::Type type, const TextureHolder& textures)
@@ -21,13 +24,13 @@ ParticleNode::ParticleNode(Particle::Type type, const TextureHolder& textures)
 {
 }
 
-void ParticleNode::addParticle(sf::Vector2f position)
+void ParticleNode::addParticles(sf::Vector2f position, std::size_t count)
 {
 	Particle particle;
 	particle.position = position;
 	particle.color = Table[mType].color;
 	particle.lifetime = Table[mType].lifetime;
-	mParticles.push_back(particle);
+	mParticles.insert(mParticles.end(), count, particle);
 }
 
 Particle::Type ParticleNode::getParticleType() const
@@ -40,14 +43,17 @@ unsigned int ParticleNode::getCategory() const
 	return Category::ParticleSystem;
 }
 
-void ParticleNode::updateCurrent(sf::Time dt, CommandQueue&)
+void ParticleNode::updateParticles(sf::Time dt, JobSystem& jobs)
 {
 	// ɾʧЧӵ
 	while (!mParticles.empty() && mParticles.front().lifetime <= sf::Time::Zero)
 		mParticles.pop_front();
-	// ٴӵĴʱ
-	FOREACH(Particle& particle, mParticles)
-		particle.lifetime -= dt;
+	// ٴӵĴʱ䣬䲢д
+	jobs.parallelFor(mParticles.size(), AgingGrainSize, [this, dt] (std::size_t begin, std::size_t end)
+	{
+		for (std::size_t i = begin; i < end; ++i)
+			mParticles[i].lifetime -= dt;
+	});
 	mNeedsVertexUpdate = true;
 }
 
@@ -64,6 +70,17 @@ void ParticleNode::drawCurrent(sf::RenderTarget& target, sf::RenderStates states
 	target.draw(mVertexArray, states);
 }
 
+void ParticleNode::snapshotCurrent(RenderSnapshot& snapshot, sf::RenderStates states) const
+{
+	if (mNeedsVertexUpdate)
+	{
+		computeVertices();
+		mNeedsVertexUpdate = false;
+	}
+	states.texture = &mTexture;
+	snapshot.addToScene(mVertexArray, states);
+}
+
 void ParticleNode::addVertex(float worldX, float worldY, float texCoordX, float texCoordY, const sf::Color& color) const
 {
 	sf::Vertex vertex;
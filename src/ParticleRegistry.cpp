@@ -0,0 +1,22 @@
+#include <Book/ParticleRegistry.hpp>
+#include <Book/ParticleNode.hpp>
+#include <cassert>
+
+ParticleRegistry::ParticleRegistry()
+: mNodes()
+{
+	mNodes.fill(nullptr);
+}
+
+void ParticleRegistry::registerNode(ParticleNode& node)
+{
+	// 每种粒子只能有一个粒子节点
+	assert(mNodes[node.getParticleType()] == nullptr);
+	mNodes[node.getParticleType()] = &node;
+}
+
+ParticleNode& ParticleRegistry::get(Particle::Type type) const
+{
+	assert(mNodes[type] != nullptr);
+	return *mNodes[type];
+}
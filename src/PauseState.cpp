@@ -3,6 +3,7 @@
 #include <Book/Utility.hpp>
 #include <Book/MusicPlayer.hpp>
 #include <Book/ResourceHolder.hpp>
+#include <Book/RenderSnapshot.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/View.hpp>
@@ -45,7 +46,7 @@ PauseState::~PauseState()
 	getContext().music->setPaused(false);
 }
 
-void PauseState::draw()
+void PauseState::draw(float)
 {
 	sf::RenderWindow& window = *getContext().window;
 	window.setView(window.getDefaultView());
@@ -57,13 +58,31 @@ void PauseState::draw()
 	window.draw(mGUIContainer);
 }
 
+void PauseState::snapshot(RenderSnapshot& snapshot, float)
+{
+	sf::RenderWindow& window = *getContext().window;
+	sf::RectangleShape backgroundShape;
+	backgroundShape.setFillColor(sf::Color(0, 0, 0, 150));
+	backgroundShape.setSize(window.getDefaultView().getSize());
+	snapshot.addToOverlay(backgroundShape);
+	snapshot.addToOverlay(mPausedText);
+	mGUIContainer.snapshot(snapshot, sf::RenderStates::Default);
+}
+
 bool PauseState::update(sf::Time)
 {
 	return false;
 }
 
+bool PauseState::freezesStatesBelow() const
+{
+	// 暂停时下面的游戏画面是静止的
+	return true;
+}
+
 bool PauseState::handleEvent(const sf::Event& event)
 {
 	mGUIContainer.handleEvent(event);
+	requestRedraw();
 	return false;
 }
@@ -4,6 +4,7 @@
 #include <Book/CommandQueue.hpp>
 #include <Book/Utility.hpp>
 #include <Book/ResourceHolder.hpp>
+#include <Book/RenderSnapshot.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 
 namespace
@@ -11,8 +12,8 @@ namespace
 	const std::vector<PickupData> Table = initializePickupData();
 }
 
-Pickup::Pickup(Type type, const TextureHolder& textures)
-: Entity(1)
+Pickup::Pickup(Type type, const TextureHolder& textures, EntityStore& entities)
+: Entity(entities, 1)
 , mType(type)
 , mSprite(textures.get(Table[type].texture), Table[type].textureRect)
 {
@@ -29,6 +30,16 @@ sf::FloatRect Pickup::getBoundingRect() const
 	return getWorldTransform().transformRect(mSprite.getGlobalBounds());
 }
 
+sf::FloatRect Pickup::getHitBox() const
+{
+	return Table[mType].hitBox;
+}
+
+sf::IntRect Pickup::getTextureRect() const
+{
+	return mSprite.getTextureRect();
+}
+
 void Pickup::apply(Aircraft& player) const
 {
 	Table[mType].action(player);
@@ -39,3 +50,7 @@ void Pickup::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) cons
 	target.draw(mSprite, states);
 }
 
+void Pickup::snapshotCurrent(RenderSnapshot& snapshot, sf::RenderStates states) const
+{
+	snapshot.addToScene(mSprite, states);
+}
@@ -3,22 +3,33 @@
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 
+namespace
+{
+	// 单位大小的全屏四边形，绘制时按输出尺寸缩放
+	sf::VertexArray createFullscreenQuad()
+	{
+		sf::VertexArray vertices(sf::TrianglesStrip, 4);
+		vertices[0] = sf::Vertex(sf::Vector2f(0, 0), sf::Vector2f(0, 1));
+		vertices[1] = sf::Vertex(sf::Vector2f(1, 0), sf::Vector2f(1, 1));
+		vertices[2] = sf::Vertex(sf::Vector2f(0, 1), sf::Vector2f(0, 0));
+		vertices[3] = sf::Vertex(sf::Vector2f(1, 1), sf::Vector2f(1, 0));
+		return vertices;
+	}
+}
+
 PostEffect::~PostEffect()
 {
 }
 
 void PostEffect::applyShader(const sf::Shader& shader, sf::RenderTarget& output)
 {
+	static const sf::VertexArray quad = createFullscreenQuad();
 	sf::Vector2f outputSize = static_cast<sf::Vector2f>(output.getSize());
-	sf::VertexArray vertices(sf::TrianglesStrip, 4);
-	vertices[0] = sf::Vertex(sf::Vector2f(0, 0),            sf::Vector2f(0, 1));
-	vertices[1] = sf::Vertex(sf::Vector2f(outputSize.x, 0), sf::Vector2f(1, 1));
-	vertices[2] = sf::Vertex(sf::Vector2f(0, outputSize.y), sf::Vector2f(0, 0));
-	vertices[3] = sf::Vertex(sf::Vector2f(outputSize),      sf::Vector2f(1, 0));
 	sf::RenderStates states;
 	states.shader 	 = &shader;
 	states.blendMode = sf::BlendNone;
-	output.draw(vertices, states);
+	states.transform.scale(outputSize.x, outputSize.y);
+	output.draw(quad, states);
 }
 
 bool PostEffect::isSupported()
@@ -3,6 +3,7 @@
 #include <Book/DataTables.hpp>
 #include <Book/Utility.hpp>
 #include <Book/ResourceHolder.hpp>
+#include <Book/RenderSnapshot.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/RenderStates.hpp>
 #include <cmath>
@@ -13,8 +14,8 @@ namespace
 	const std::vector<ProjectileData> Table = initializeProjectileData();
 }
 
-Projectile::Projectile(Type type, const TextureHolder& textures)
-: Entity(1)
+Projectile::Projectile(Type type, const TextureHolder& textures, EntityStore& entities, const ParticleRegistry& particles)
+: Entity(entities, 1)
 , mType(type)
 , mSprite(textures.get(Table[type].texture), Table[type].textureRect)
 , mTargetDirection()
@@ -23,10 +24,10 @@ Projectile::Projectile(Type type, const TextureHolder& textures)
 	// ӵϵͳ
 	if (isGuided())
 	{
-		std::unique_ptr<EmitterNode> smoke(new EmitterNode(Particle::Smoke));
+		std::unique_ptr<EmitterNode> smoke(new EmitterNode(Particle::Smoke, particles));
 		smoke->setPosition(0.f, getBoundingRect().height / 2.f);
 		attachChild(std::move(smoke));
-		std::unique_ptr<EmitterNode> propellant(new EmitterNode(Particle::Propellant));
+		std::unique_ptr<EmitterNode> propellant(new EmitterNode(Particle::Propellant, particles));
 		propellant->setPosition(0.f, getBoundingRect().height / 2.f);
 		attachChild(std::move(propellant));
 	}
@@ -43,7 +44,7 @@ bool Projectile::isGuided() const
 	return mType == Missile;
 }
 
-void Projectile::updateCurrent(sf::Time dt, CommandQueue& commands)
+void Projectile::steer(sf::Time dt)
 {
 	if (isGuided())
 	{
@@ -54,8 +55,6 @@ void Projectile::updateCurrent(sf::Time dt, CommandQueue& commands)
 		setRotation(toDegree(angle) + 90.f);
 		setVelocity(newVelocity);
 	}
-
-	Entity::updateCurrent(dt, commands);
 }
 
 void Projectile::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const
@@ -63,6 +62,11 @@ void Projectile::drawCurrent(sf::RenderTarget& target, sf::RenderStates states)
 	target.draw(mSprite, states);
 }
 
+void Projectile::snapshotCurrent(RenderSnapshot& snapshot, sf::RenderStates states) const
+{
+	snapshot.addToScene(mSprite, states);
+}
+
 unsigned int Projectile::getCategory() const
 {
 	if (mType == EnemyBullet)
@@ -76,6 +80,16 @@ sf::FloatRect Projectile::getBoundingRect() const
 	return getWorldTransform().transformRect(mSprite.getGlobalBounds());
 }
 
+sf::FloatRect Projectile::getHitBox() const
+{
+	return Table[mType].hitBox;
+}
+
+sf::IntRect Projectile::getTextureRect() const
+{
+	return mSprite.getTextureRect();
+}
+
 float Projectile::getMaxSpeed() const
 {
 	return Table[mType].speed;
@@ -0,0 +1,58 @@
+#include <Book/RandomGenerator.hpp>
+#include <cassert>
+
+namespace
+{
+	const sf::Uint64 Multiplier = 6364136223846793005ULL;
+	const sf::Uint64 Increment = 1442695040888963407ULL;
+}
+
+RandomGenerator::RandomGenerator(sf::Uint64 seed)
+: mSeed(seed)
+, mState(0)
+{
+	setSeed(seed);
+}
+
+void RandomGenerator::setSeed(sf::Uint64 seed)
+{
+	mSeed = seed;
+	mState = 0;
+	next();
+	mState += seed;
+	next();
+}
+
+sf::Uint64 RandomGenerator::getSeed() const
+{
+	return mSeed;
+}
+
+sf::Uint32 RandomGenerator::next()
+{
+	// 线性同余推进状态，输出经过异或移位和随机旋转
+	sf::Uint64 state = mState;
+	mState = state * Multiplier + Increment;
+	sf::Uint32 xorshifted = static_cast<sf::Uint32>(((state >> 18u) ^ state) >> 27u);
+	sf::Uint32 rotation = static_cast<sf::Uint32>(state >> 59u);
+	return (xorshifted >> rotation) | (xorshifted << ((0u - rotation) & 31u));
+}
+
+int RandomGenerator::nextInt(int exclusiveMax)
+{
+	// 乘法取高位映射到 [0, exclusiveMax)，拒绝落在余数区间的低位以消除偏差
+	assert(exclusiveMax > 0);
+	sf::Uint32 range = static_cast<sf::Uint32>(exclusiveMax);
+	sf::Uint64 product = static_cast<sf::Uint64>(next()) * range;
+	sf::Uint32 low = static_cast<sf::Uint32>(product);
+	if (low < range)
+	{
+		sf::Uint32 threshold = (0u - range) % range;
+		while (low < threshold)
+		{
+			product = static_cast<sf::Uint64>(next()) * range;
+			low = static_cast<sf::Uint32>(product);
+		}
+	}
+	return static_cast<int>(product >> 32);
+}
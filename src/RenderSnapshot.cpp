@@ -0,0 +1,113 @@
+#include <Book/RenderSnapshot.hpp>
+#include <Book/Foreach.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+
+RenderSnapshot::RenderSnapshot()
+: mSceneView()
+, mSceneItems()
+, mOverlayItems()
+{
+}
+
+void RenderSnapshot::clear()
+{
+	mSceneItems.clear();
+	mOverlayItems.clear();
+}
+
+bool RenderSnapshot::isEmpty() const
+{
+	return mSceneItems.empty() && mOverlayItems.empty();
+}
+
+void RenderSnapshot::setSceneView(const sf::View& view)
+{
+	mSceneView = view;
+}
+
+void RenderSnapshot::addToScene(const sf::Text& text, const sf::RenderStates& states)
+{
+	addText(mSceneItems, text, states);
+}
+
+void RenderSnapshot::addToOverlay(const sf::Text& text, const sf::RenderStates& states)
+{
+	addText(mOverlayItems, text, states);
+}
+
+bool RenderSnapshot::hasScene() const
+{
+	return !mSceneItems.empty();
+}
+
+void RenderSnapshot::drawScene(sf::RenderTarget& target) const
+{
+	target.setView(mSceneView);
+	drawItems(mSceneItems, target);
+}
+
+void RenderSnapshot::drawOverlay(sf::RenderTarget& target) const
+{
+	target.setView(target.getDefaultView());
+	drawItems(mOverlayItems, target);
+}
+
+void RenderSnapshot::addText(std::vector<Item>& items, const sf::Text& text, sf::RenderStates states)
+{
+	// 在记录线程上按 sf::Text 的排版规则生成顶点（游戏中没有用到下划线，不处理）
+	const sf::Font* font = text.getFont();
+	const sf::String& string = text.getString();
+	if (!font || string.isEmpty())
+		return;
+	unsigned int size = text.getCharacterSize();
+	bool bold = (text.getStyle() & sf::Text::Bold) != 0;
+	float italic = (text.getStyle() & sf::Text::Italic) ? 0.208f : 0.f;
+	float hspace = static_cast<float>(font->getGlyph(L' ', size, bold).advance);
+	float vspace = static_cast<float>(font->getLineSpacing(size));
+	sf::Color color = text.getColor();
+	std::unique_ptr<sf::VertexArray> vertices(new sf::VertexArray(sf::Quads));
+	float x = 0.f;
+	float y = static_cast<float>(size);
+	sf::Uint32 previous = 0;
+	for (std::size_t i = 0; i < string.getSize(); ++i)
+	{
+		sf::Uint32 current = string[i];
+		x += static_cast<float>(font->getKerning(previous, current, size));
+		previous = current;
+		switch (current)
+		{
+			case ' ':	x += hspace;		continue;
+			case '\t':	x += hspace * 4;	continue;
+			case '\n':	y += vspace; x = 0.f;	continue;
+		}
+		const sf::Glyph& glyph = font->getGlyph(current, size, bold);
+		float left = static_cast<float>(glyph.bounds.left);
+		float top = static_cast<float>(glyph.bounds.top);
+		float right = left + glyph.bounds.width;
+		float bottom = top + glyph.bounds.height;
+		float u1 = static_cast<float>(glyph.textureRect.left);
+		float v1 = static_cast<float>(glyph.textureRect.top);
+		float u2 = u1 + glyph.textureRect.width;
+		float v2 = v1 + glyph.textureRect.height;
+		vertices->append(sf::Vertex(sf::Vector2f(x + left - italic * top, y + top), color, sf::Vector2f(u1, v1)));
+		vertices->append(sf::Vertex(sf::Vector2f(x + right - italic * top, y + top), color, sf::Vector2f(u2, v1)));
+		vertices->append(sf::Vertex(sf::Vector2f(x + right - italic * bottom, y + bottom), color, sf::Vector2f(u2, v2)));
+		vertices->append(sf::Vertex(sf::Vector2f(x + left - italic * bottom, y + bottom), color, sf::Vector2f(u1, v2)));
+		x += static_cast<float>(glyph.advance);
+	}
+	states.transform *= text.getTransform();
+	states.texture = &font->getTexture(size);
+	Item item;
+	item.drawable = std::move(vertices);
+	item.states = states;
+	items.push_back(std::move(item));
+}
+
+void RenderSnapshot::drawItems(const std::vector<Item>& items, sf::RenderTarget& target)
+{
+	FOREACH(const Item& item, items)
+		target.draw(*item.drawable, item.states);
+}
@@ -0,0 +1,106 @@
+#include <Book/RenderTargetPool.hpp>
+#include <cassert>
+#include <stdexcept>
+
+RenderTargetPool::RenderTargetPool(std::size_t memoryBudget, unsigned int maxIdleFrames)
+: mEntries()
+, mMemoryBudget(memoryBudget)
+, mMemoryUsage(0)
+, mMaxIdleFrames(maxIdleFrames)
+, mFrame(0)
+{
+}
+
+sf::RenderTexture& RenderTargetPool::acquire(sf::Vector2u size, bool depthBuffer)
+{
+	// 优先复用尺寸和格式都相同的空闲目标
+	for (std::size_t i = 0; i < mEntries.size(); ++i)
+	{
+		Entry& entry = *mEntries[i];
+		if (!entry.inUse && entry.size == size && entry.depthBuffer == depthBuffer)
+		{
+			entry.inUse = true;
+			entry.lastUsedFrame = mFrame;
+			return entry.texture;
+		}
+	}
+	// 超出预算时先释放最久未用的空闲目标
+	std::size_t entrySize = getEntrySize(size, depthBuffer);
+	while (mMemoryUsage + entrySize > mMemoryBudget && evictLeastRecentlyUsed())
+	{
+	}
+	EntryPtr entry(new Entry());
+	entry->size = size;
+	entry->depthBuffer = depthBuffer;
+	entry->inUse = true;
+	entry->lastUsedFrame = mFrame;
+	if (!entry->texture.create(size.x, size.y, depthBuffer))
+		throw std::runtime_error("RenderTargetPool::acquire - Failed to create render texture");
+	mMemoryUsage += entrySize;
+	mEntries.push_back(std::move(entry));
+	return mEntries.back()->texture;
+}
+
+void RenderTargetPool::release(sf::RenderTexture& target)
+{
+	for (std::size_t i = 0; i < mEntries.size(); ++i)
+	{
+		if (&mEntries[i]->texture == &target)
+		{
+			assert(mEntries[i]->inUse);
+			mEntries[i]->inUse = false;
+			return;
+		}
+	}
+	assert(false);
+}
+
+void RenderTargetPool::endFrame()
+{
+	// 长时间未被借用的目标（例如窗口尺寸变化前的）被释放
+	++mFrame;
+	for (std::size_t i = mEntries.size(); i > 0; --i)
+	{
+		const Entry& entry = *mEntries[i - 1];
+		if (!entry.inUse && mFrame - entry.lastUsedFrame > mMaxIdleFrames)
+			erase(i - 1);
+	}
+}
+
+std::size_t RenderTargetPool::getTargetCount() const
+{
+	return mEntries.size();
+}
+
+std::size_t RenderTargetPool::getMemoryUsage() const
+{
+	return mMemoryUsage;
+}
+
+std::size_t RenderTargetPool::getEntrySize(sf::Vector2u size, bool depthBuffer)
+{
+	// 按每像素4字节颜色估算，深度缓冲再加4字节
+	return static_cast<std::size_t>(size.x) * size.y * (depthBuffer ? 8 : 4);
+}
+
+bool RenderTargetPool::evictLeastRecentlyUsed()
+{
+	std::size_t victim = mEntries.size();
+	for (std::size_t i = 0; i < mEntries.size(); ++i)
+	{
+		const Entry& entry = *mEntries[i];
+		if (!entry.inUse && (victim == mEntries.size() || entry.lastUsedFrame < mEntries[victim]->lastUsedFrame))
+			victim = i;
+	}
+	if (victim == mEntries.size())
+		return false;
+	erase(victim);
+	return true;
+}
+
+void RenderTargetPool::erase(std::size_t index)
+{
+	const Entry& entry = *mEntries[index];
+	mMemoryUsage -= getEntrySize(entry.size, entry.depthBuffer);
+	mEntries.erase(mEntries.begin() + index);
+}
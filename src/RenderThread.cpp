@@ -0,0 +1,196 @@
+#include <Book/RenderThread.hpp>
+#include <Book/JobSystem.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/OpenGL.hpp>
+#include <utility>
+
+RenderThread::RenderThread(sf::RenderWindow& window, JobSystem& jobs)
+: mWindow(window)
+, mJobs(jobs)
+, mRenderTargets()
+, mBloomEffect(mRenderTargets)
+, mCpuBloomEffect(jobs)
+, mGraphics()
+, mFrameLimiter(0)
+, mStatistics()
+, mSnapshots()
+, mBackIndex(0)
+, mReadyIndex(1)
+, mFrontIndex(2)
+, mHasNewSnapshot(false)
+, mRunning(false)
+, mMutex()
+, mFrameMutex()
+, mCondition()
+, mThread()
+{
+	// 窗口的OpenGL上下文交给渲染线程
+	mWindow.setActive(false);
+	mRunning = true;
+	mThread = std::thread(&RenderThread::run, this);
+}
+
+RenderThread::~RenderThread()
+{
+	stop();
+}
+
+void RenderThread::stop()
+{
+	if (!mThread.joinable())
+		return;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mRunning = false;
+	}
+	mCondition.notify_all();
+	mThread.join();
+	mWindow.setActive(true);
+}
+
+RenderSnapshot& RenderThread::getBackSnapshot()
+{
+	return mSnapshots[mBackIndex];
+}
+
+void RenderThread::publish()
+{
+	// 只交换缓冲区下标，渲染线程还没取走的快照被这一份覆盖，绘制再慢也不会拖慢模拟
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		std::swap(mBackIndex, mReadyIndex);
+		mHasNewSnapshot = true;
+	}
+	mCondition.notify_all();
+	mSnapshots[mBackIndex].clear();
+}
+
+void RenderThread::flush()
+{
+	// 状态切换前调用：等待当前帧画完，丢弃所有引用旧资源的快照
+	std::lock_guard<std::mutex> frameLock(mFrameMutex);
+	std::lock_guard<std::mutex> lock(mMutex);
+	for (std::size_t i = 0; i < mSnapshots.size(); ++i)
+		mSnapshots[i].clear();
+	mHasNewSnapshot = false;
+}
+
+void RenderThread::setGraphicsSettings(const GraphicsSettings& graphics)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mGraphics = graphics;
+}
+
+RenderThread::Statistics RenderThread::getStatistics() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mStatistics;
+}
+
+void RenderThread::run()
+{
+	mWindow.setActive(true);
+	GraphicsSettings graphics;
+	bool verticalSync = graphics.isVerticalSyncEnabled();
+	unsigned int framerate = 0;
+	mWindow.setVerticalSyncEnabled(verticalSync);
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mCondition.wait(lock, [this] () { return !mRunning || mHasNewSnapshot; });
+			if (!mRunning)
+				break;
+			std::swap(mFrontIndex, mReadyIndex);
+			mHasNewSnapshot = false;
+			graphics = mGraphics;
+		}
+		mCondition.notify_all();
+		if (graphics.isVerticalSyncEnabled() != verticalSync)
+		{
+			verticalSync = graphics.isVerticalSyncEnabled();
+			mWindow.setVerticalSyncEnabled(verticalSync);
+		}
+		// 垂直同步和帧率限制只启用其一，与单线程时相同
+		unsigned int limit = verticalSync ? 0 : graphics.getFramerateLimit();
+		if (limit != framerate)
+		{
+			mFrameLimiter.setFramerate(limit);
+			framerate = limit;
+		}
+		{
+			std::lock_guard<std::mutex> frameLock(mFrameMutex);
+			render(mSnapshots[mFrontIndex], graphics);
+		}
+		mFrameLimiter.wait();
+	}
+	// CPU泛光在本线程调用过 parallelFor，线程结束前归还它占用的队列
+	mJobs.unregisterCaller();
+	mWindow.setActive(false);
+}
+
+void RenderThread::render(const RenderSnapshot& snapshot, const GraphicsSettings& graphics)
+{
+	// 快照在状态切换时被清空，此时保留上一帧画面
+	if (snapshot.isEmpty())
+		return;
+	sf::Clock clock;
+	mWindow.clear();
+	if (snapshot.hasScene())
+		drawScene(snapshot, graphics);
+	snapshot.drawOverlay(mWindow);
+	// 动态分辨率需要包含GPU时间的渲染耗时，等待GPU完成后再计时，不含垂直同步等待
+	if (graphics.isDynamicResolutionEnabled())
+		glFinish();
+	sf::Time renderTime = clock.getElapsedTime();
+	mWindow.display();
+	mRenderTargets.endFrame();
+	// 统计数据只在这里写入，主线程通过 getStatistics 加锁读取
+	std::lock_guard<std::mutex> lock(mMutex);
+	mStatistics.renderTime = renderTime;
+	mStatistics.frameCount += 1;
+	mStatistics.targetCount = mRenderTargets.getTargetCount();
+	mStatistics.targetMemory = mRenderTargets.getMemoryUsage();
+}
+
+void RenderThread::drawScene(const RenderSnapshot& snapshot, const GraphicsSettings& graphics)
+{
+	// 与 World::draw 相同：缩小的场景纹理和泛光，纹理都在本线程的上下文中创建
+	sf::Vector2u targetSize = mWindow.getSize();
+	float scale = graphics.getResolutionScale();
+	sf::Vector2u sceneSize(static_cast<unsigned int>(targetSize.x * scale), static_cast<unsigned int>(targetSize.y * scale));
+	bool scaled = (sceneSize != targetSize);
+	BloomEffect::Quality quality = graphics.getBloomQuality();
+	bool cpuBloom = graphics.usesCpuBloom();
+	if (!(cpuBloom || PostEffect::isSupported()) || (quality == BloomEffect::Off && !scaled))
+	{
+		snapshot.drawScene(mWindow);
+		return;
+	}
+	sf::RenderTexture& sceneTexture = mRenderTargets.acquire(sceneSize);
+	sceneTexture.setSmooth(scaled);
+	sceneTexture.clear();
+	snapshot.drawScene(sceneTexture);
+	sceneTexture.display();
+	BloomEffect::Statistics statistics;
+	if (cpuBloom)
+	{
+		mCpuBloomEffect.setQuality(quality);
+		mCpuBloomEffect.setUpdateInterval(graphics.getBloomUpdateInterval());
+		mCpuBloomEffect.setHistoryWeight(graphics.getBloomHistoryWeight());
+		mCpuBloomEffect.apply(sceneTexture, mWindow);
+		statistics = mCpuBloomEffect.getStatistics();
+	}
+	else
+	{
+		mBloomEffect.setQuality(quality);
+		mBloomEffect.setUpdateInterval(graphics.getBloomUpdateInterval());
+		mBloomEffect.setHistoryWeight(graphics.getBloomHistoryWeight());
+		mBloomEffect.apply(sceneTexture, mWindow);
+		statistics = mBloomEffect.getStatistics();
+	}
+	mRenderTargets.release(sceneTexture);
+	std::lock_guard<std::mutex> lock(mMutex);
+	mStatistics.bloom = statistics;
+}
@@ -0,0 +1,74 @@
+#include <Book/ResolutionScaler.hpp>
+#include <algorithm>
+
+const std::size_t ResolutionScaler::SampleFrames = 30;
+const float ResolutionScaler::Tolerance = 1.05f;
+const std::size_t ResolutionScaler::MaxUpscaleDelay = 16;
+
+ResolutionScaler::ResolutionScaler(sf::Time targetFrameTime, float minScale, float step)
+: mTargetFrameTime(targetFrameTime)
+, mMinScale(minScale)
+, mStep(step)
+, mScale(1.f)
+, mAccumulatedTime(sf::Time::Zero)
+, mSampleCount(0)
+, mStableWindows(0)
+, mUpscaleDelay(2)
+, mLastChangeWasUpscale(false)
+{
+}
+
+void ResolutionScaler::setTargetFrameTime(sf::Time targetFrameTime)
+{
+	mTargetFrameTime = targetFrameTime;
+}
+
+void ResolutionScaler::addFrame(sf::Time renderTime)
+{
+	// 按若干帧的平均渲染时间调整，避免单帧波动引起抖动
+	mAccumulatedTime += renderTime;
+	if (++mSampleCount < SampleFrames)
+		return;
+	sf::Time average = mAccumulatedTime / static_cast<sf::Int64>(mSampleCount);
+	mAccumulatedTime = sf::Time::Zero;
+	mSampleCount = 0;
+	if (average.asSeconds() > mTargetFrameTime.asSeconds() * Tolerance)
+	{
+		// 刚提高分辨率就超时，说明提高得太早，下次多等一段时间
+		if (mLastChangeWasUpscale)
+			mUpscaleDelay = std::min(mUpscaleDelay * 2, MaxUpscaleDelay);
+		mStableWindows = 0;
+		changeScale(-mStep);
+		mLastChangeWasUpscale = false;
+	}
+	else if (++mStableWindows >= mUpscaleDelay && mScale < 1.f)
+	{
+		mStableWindows = 0;
+		changeScale(mStep);
+		mLastChangeWasUpscale = true;
+	}
+	else
+	{
+		mLastChangeWasUpscale = false;
+	}
+}
+
+void ResolutionScaler::reset()
+{
+	mScale = 1.f;
+	mAccumulatedTime = sf::Time::Zero;
+	mSampleCount = 0;
+	mStableWindows = 0;
+	mUpscaleDelay = 2;
+	mLastChangeWasUpscale = false;
+}
+
+float ResolutionScaler::getScale() const
+{
+	return mScale;
+}
+
+void ResolutionScaler::changeScale(float delta)
+{
+	mScale = std::max(mMinScale, std::min(1.f, mScale + delta));
+}
@@ -4,33 +4,68 @@
 #include <Book/Utility.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
-#include <algorithm>
 #include <cassert>
 #include <cmath>
 
 SceneNode::SceneNode(Category::Type category)
 : mChildren()
 , mParent(nullptr)
+, mIndexInParent(0)
 , mDefaultCategory(category)
+, mPreviousPosition()
+, mPreviousRotation(0.f)
+, mHasPreviousTransform(false)
 {
 }
 
 void SceneNode::attachChild(Ptr child)
 {
 	child->mParent = this;
+	child->mIndexInParent = mChildren.size();
 	mChildren.push_back(std::move(child));
 }
 
 SceneNode::Ptr SceneNode::detachChild(const SceneNode& node)
 {
-	auto found = std::find_if(mChildren.begin(), mChildren.end(), [&] (Ptr& p) { return p.get() == &node; });
-	assert(found != mChildren.end());
-	Ptr result = std::move(*found);
+	Ptr result = releaseChild(node);
+	compactChildren();
+	return result;
+}
+
+SceneNode::Ptr SceneNode::releaseChild(const SceneNode& node)
+{
+	// 节点记录了自己在父节点中的位置，O(1) 取出后留下空位；
+	// 下一次遍历子节点之前必须调用 compactChildren，批量删除时每个父节点只压缩一次
+	std::size_t index = node.mIndexInParent;
+	assert(node.mParent == this && mChildren[index].get() == &node);
+	Ptr result = std::move(mChildren[index]);
 	result->mParent = nullptr;
-	mChildren.erase(found);
 	return result;
 }
 
+void SceneNode::compactChildren()
+{
+	// 保持顺序地去掉空位，兄弟节点的绘制顺序（谁画在上面）不因删除而改变
+	std::size_t count = 0;
+	for (std::size_t i = 0; i < mChildren.size(); ++i)
+	{
+		if (!mChildren[i])
+			continue;
+		if (count != i)
+		{
+			mChildren[count] = std::move(mChildren[i]);
+			mChildren[count]->mIndexInParent = count;
+		}
+		++count;
+	}
+	mChildren.resize(count);
+}
+
+SceneNode* SceneNode::getParent() const
+{
+	return mParent;
+}
+
 void SceneNode::update(sf::Time dt, CommandQueue& commands)
 {
 	updateCurrent(dt, commands);
@@ -49,11 +84,16 @@ void SceneNode::updateChildren(sf::Time dt, CommandQueue& commands)
 
 void SceneNode::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
-	// 申请当前节点的转换
-	states.transform *= getTransform();
+	drawInterpolated(target, states, 1.f);
+}
+
+void SceneNode::drawInterpolated(sf::RenderTarget& target, sf::RenderStates states, float alpha) const
+{
+	// 申请当前节点在上一步与当前步之间插值的转换
+	states.transform *= getInterpolatedTransform(alpha);
 	// 显示节点和转换后的子节点
-	drawCurrent(target, states);
-	drawChildren(target, states);
+	drawCurrentInterpolated(target, states, alpha);
+	drawChildren(target, states, alpha);
 	// 显示边界矩形，默认关闭
 	//drawBoundingRect(target, states);
 }
@@ -62,10 +102,34 @@ void SceneNode::drawCurrent(sf::RenderTarget&, sf::RenderStates) const
 {
 }
 
-void SceneNode::drawChildren(sf::RenderTarget& target, sf::RenderStates states) const
+void SceneNode::drawCurrentInterpolated(sf::RenderTarget& target, sf::RenderStates states, float) const
+{
+	// 自身包含多个运动对象的节点可以重写此函数，自行插值
+	drawCurrent(target, states);
+}
+
+void SceneNode::drawChildren(sf::RenderTarget& target, sf::RenderStates states, float alpha) const
 {
 	FOREACH(const Ptr& child, mChildren)
-		child->draw(target, states);
+		child->drawInterpolated(target, states, alpha);
+}
+
+void SceneNode::snapshot(RenderSnapshot& snapshot, sf::RenderStates states, float alpha) const
+{
+	// 与draw相同的遍历顺序和插值，把绘制内容复制到快照中
+	states.transform *= getInterpolatedTransform(alpha);
+	snapshotCurrentInterpolated(snapshot, states, alpha);
+	FOREACH(const Ptr& child, mChildren)
+		child->snapshot(snapshot, states, alpha);
+}
+
+void SceneNode::snapshotCurrent(RenderSnapshot&, sf::RenderStates) const
+{
+}
+
+void SceneNode::snapshotCurrentInterpolated(RenderSnapshot& snapshot, sf::RenderStates states, float) const
+{
+	snapshotCurrent(snapshot, states);
 }
 
 void SceneNode::drawBoundingRect(sf::RenderTarget& target, sf::RenderStates) const
@@ -93,6 +157,31 @@ sf::Transform SceneNode::getWorldTransform() const
 	return transform;
 }
 
+void SceneNode::savePreviousTransform()
+{
+	// 每一步更新前记录位置和角度，供绘制时插值
+	mPreviousPosition = getPosition();
+	mPreviousRotation = getRotation();
+	mHasPreviousTransform = true;
+	FOREACH(Ptr& child, mChildren)
+		child->savePreviousTransform();
+}
+
+sf::Transform SceneNode::getInterpolatedTransform(float alpha) const
+{
+	// 本步新建的节点没有上一步的数据，直接使用当前转换
+	if (!mHasPreviousTransform || alpha >= 1.f)
+		return getTransform();
+	// 角度沿较短的方向插值
+	float rotationDelta = std::fmod(getRotation() - mPreviousRotation + 540.f, 360.f) - 180.f;
+	sf::Transformable interpolated;
+	interpolated.setOrigin(getOrigin());
+	interpolated.setScale(getScale());
+	interpolated.setPosition(mPreviousPosition + (getPosition() - mPreviousPosition) * alpha);
+	interpolated.setRotation(mPreviousRotation + rotationDelta * alpha);
+	return interpolated.getTransform();
+}
+
 void SceneNode::onCommand(const Command& command, sf::Time dt)
 {
 	// 如果类型匹配的话，就将命令传给当前节点
@@ -108,30 +197,6 @@ unsigned int SceneNode::getCategory() const
 	return mDefaultCategory;
 }
 
-void SceneNode::checkSceneCollision(SceneNode& sceneGraph, std::set<Pair>& collisionPairs)
-{
-	checkNodeCollision(sceneGraph, collisionPairs);
-	FOREACH(Ptr& child, sceneGraph.mChildren)
-		checkSceneCollision(*child, collisionPairs);
-}
-
-void SceneNode::checkNodeCollision(SceneNode& node, std::set<Pair>& collisionPairs)
-{
-	if (this != &node && collision(*this, node) && !isDestroyed() && !node.isDestroyed())
-		collisionPairs.insert(std::minmax(this, &node));
-	FOREACH(Ptr& child, mChildren)
-		child->checkNodeCollision(node, collisionPairs);
-}
-
-void SceneNode::removeWrecks()
-{
-	// 删除所有子节点的请求
-	auto wreckfieldBegin = std::remove_if (mChildren.begin(), mChildren.end(), std::mem_fn(&SceneNode::isMarkedForRemoval));
-	mChildren.erase(wreckfieldBegin, mChildren.end());
-	// 递归调用所有剩余的子节点
-	std::for_each(mChildren.begin(), mChildren.end(), std::mem_fn(&SceneNode::removeWrecks));
-}
-
 sf::FloatRect SceneNode::getBoundingRect() const
 {
 	return sf::FloatRect();
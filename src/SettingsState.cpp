@@ -1,11 +1,30 @@
 #include <Book/SettingsState.hpp>
 #include <Book/Utility.hpp>
 #include <Book/ResourceHolder.hpp>
+#include <Book/RenderSnapshot.hpp>
+#include <Book/GraphicsSettings.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <algorithm>
+
+namespace
+{
+	// ֱ֮ͬл֡ޣ0 ʾ
+	const unsigned int Framerates[] = {60, 120, 144, 0};
+	const std::size_t FramerateCount = sizeof(Framerates) / sizeof(Framerates[0]);
+}
 
 SettingsState::SettingsState(StateStack& stack, Context context)
 : State(stack, context)
 , mGUIContainer()
+, mBindingButtons()
+, mBindingLabels()
+, mBloomButton()
+, mResolutionButton()
+, mBloomDeviceButton()
+, mBloomRateButton()
+, mRenderThreadButton()
+, mFramerateButton()
+, mStatisticsButton()
 {
 	mBackgroundSprite.setTexture(context.textures->get(Textures::TitleScreen));
 
@@ -17,28 +36,132 @@ SettingsState::SettingsState(StateStack& stack, Context context)
 	addButtonLabel(Player::Fire,			500.f, "Fire", context);
 	addButtonLabel(Player::LaunchMissile,	550.f, "Missile", context);
 	updateLabels();
+	// ťÿεлһ
+	mBloomButton = std::make_shared<GUI::Button>(context);
+	mBloomButton->setPosition(80.f, 600.f);
+	mBloomButton->setCallback([this] ()
+	{
+		GraphicsSettings& graphics = *getContext().graphics;
+		int next = (graphics.getBloomQuality() + 1) % BloomEffect::QualityCount;
+		graphics.setBloomQuality(static_cast<BloomEffect::Quality>(next));
+		updateBloomLabel();
+	});
+	mGUIContainer.pack(mBloomButton);
+	updateBloomLabel();
+	// ֱ̬ʿ
+	mResolutionButton = std::make_shared<GUI::Button>(context);
+	mResolutionButton->setPosition(300.f, 600.f);
+	mResolutionButton->setCallback([this] ()
+	{
+		GraphicsSettings& graphics = *getContext().graphics;
+		graphics.setDynamicResolutionEnabled(!graphics.isDynamicResolutionEnabled());
+		updateResolutionLabel();
+	});
+	mGUIContainer.pack(mResolutionButton);
+	updateResolutionLabel();
+	// 豸Զ / GPU / CPU
+	mBloomDeviceButton = std::make_shared<GUI::Button>(context);
+	mBloomDeviceButton->setPosition(300.f, 670.f);
+	mBloomDeviceButton->setCallback([this] ()
+	{
+		GraphicsSettings& graphics = *getContext().graphics;
+		int next = (graphics.getBloomDevice() + 1) % GraphicsSettings::BloomDeviceCount;
+		graphics.setBloomDevice(static_cast<GraphicsSettings::BloomDevice>(next));
+		updateBloomDeviceLabel();
+	});
+	mGUIContainer.pack(mBloomDeviceButton);
+	updateBloomDeviceLabel();
+	// Ƶʣÿ֡ÿ2֡ÿ3֡¼һ
+	mBloomRateButton = std::make_shared<GUI::Button>(context);
+	mBloomRateButton->setPosition(520.f, 600.f);
+	mBloomRateButton->setCallback([this] ()
+	{
+		GraphicsSettings& graphics = *getContext().graphics;
+		graphics.setBloomUpdateInterval(graphics.getBloomUpdateInterval() % 3 + 1);
+		updateBloomRateLabel();
+	});
+	mGUIContainer.pack(mBloomRateButton);
+	updateBloomRateLabel();
+	// Ⱦ߳̿أһ֡ʼʱл
+	mRenderThreadButton = std::make_shared<GUI::Button>(context);
+	mRenderThreadButton->setPosition(520.f, 670.f);
+	mRenderThreadButton->setCallback([this] ()
+	{
+		GraphicsSettings& graphics = *getContext().graphics;
+		graphics.setRenderThreadEnabled(!graphics.isRenderThreadEnabled());
+		updateRenderThreadLabel();
+	});
+	mGUIContainer.pack(mRenderThreadButton);
+	updateRenderThreadLabel();
+	// ֡ʣֱͬ / 60 / 120 / 144 / 
+	mFramerateButton = std::make_shared<GUI::Button>(context);
+	mFramerateButton->setPosition(740.f, 600.f);
+	mFramerateButton->setCallback([this] ()
+	{
+		GraphicsSettings& graphics = *getContext().graphics;
+		if (graphics.isVerticalSyncEnabled())
+		{
+			graphics.setVerticalSyncEnabled(false);
+			graphics.setFramerateLimit(Framerates[0]);
+		}
+		else
+		{
+			std::size_t current = std::find(Framerates, Framerates + FramerateCount, graphics.getFramerateLimit()) - Framerates;
+			if (current + 1 >= FramerateCount)
+				graphics.setVerticalSyncEnabled(true);
+			else
+				graphics.setFramerateLimit(Framerates[current + 1]);
+		}
+		updateFramerateLabel();
+	});
+	mGUIContainer.pack(mFramerateButton);
+	updateFramerateLabel();
+	// Ͻǵ֡ʺͷʱͳ
+	mStatisticsButton = std::make_shared<GUI::Button>(context);
+	mStatisticsButton->setPosition(740.f, 670.f);
+	mStatisticsButton->setCallback([this] ()
+	{
+		GraphicsSettings& graphics = *getContext().graphics;
+		graphics.setStatisticsVisible(!graphics.isStatisticsVisible());
+		updateStatisticsLabel();
+	});
+	mGUIContainer.pack(mStatisticsButton);
+	updateStatisticsLabel();
 	auto backButton = std::make_shared<GUI::Button>(context);
-	backButton->setPosition(80.f, 620.f);
+	backButton->setPosition(80.f, 670.f);
 	backButton->setText("Back");
 	backButton->setCallback(std::bind(&SettingsState::requestStackPop, this));
 	mGUIContainer.pack(backButton);
 }
 
-void SettingsState::draw()
+void SettingsState::draw(float)
 {
 	sf::RenderWindow& window = *getContext().window;
+	window.setView(window.getDefaultView());
 	window.draw(mBackgroundSprite);
 	window.draw(mGUIContainer);
 }
 
+void SettingsState::snapshot(RenderSnapshot& snapshot, float)
+{
+	snapshot.addToOverlay(mBackgroundSprite);
+	mGUIContainer.snapshot(snapshot, sf::RenderStates::Default);
+}
+
 bool SettingsState::update(sf::Time)
 {
 	return true;
 }
 
+bool SettingsState::isOpaque() const
+{
+	return true;
+}
+
 bool SettingsState::handleEvent(const sf::Event& event)
 {
 	bool isKeyBinding = false;
+	requestRedraw();
 
 	// Чȴ
 	for (std::size_t action = 0; action < Player::ActionCount; ++action)
@@ -73,6 +196,52 @@ void SettingsState::updateLabels()
 	}
 }
 
+void SettingsState::updateBloomLabel()
+{
+	BloomEffect::Quality quality = getContext().graphics->getBloomQuality();
+	mBloomButton->setText("Bloom: " + std::string(BloomEffect::getQualityName(quality)));
+}
+
+void SettingsState::updateResolutionLabel()
+{
+	bool dynamic = getContext().graphics->isDynamicResolutionEnabled();
+	mResolutionButton->setText(dynamic ? "Resolution: Dynamic" : "Resolution: Native");
+}
+
+void SettingsState::updateBloomDeviceLabel()
+{
+	GraphicsSettings::BloomDevice device = getContext().graphics->getBloomDevice();
+	mBloomDeviceButton->setText("Bloom on: " + std::string(GraphicsSettings::getBloomDeviceName(device)));
+}
+
+void SettingsState::updateBloomRateLabel()
+{
+	unsigned int interval = getContext().graphics->getBloomUpdateInterval();
+	mBloomRateButton->setText(interval == 1 ? "Bloom rate: Full" : "Bloom rate: 1/" + toString(interval));
+}
+
+void SettingsState::updateRenderThreadLabel()
+{
+	bool threaded = getContext().graphics->isRenderThreadEnabled();
+	mRenderThreadButton->setText(threaded ? "Render thread: On" : "Render thread: Off");
+}
+
+void SettingsState::updateFramerateLabel()
+{
+	const GraphicsSettings& graphics = *getContext().graphics;
+	unsigned int framerate = graphics.getFramerateLimit();
+	if (graphics.isVerticalSyncEnabled())
+		mFramerateButton->setText("Frame rate: VSync");
+	else
+		mFramerateButton->setText(framerate == 0 ? "Frame rate: Unlimited" : "Frame rate: " + toString(framerate));
+}
+
+void SettingsState::updateStatisticsLabel()
+{
+	bool visible = getContext().graphics->isStatisticsVisible();
+	mStatisticsButton->setText(visible ? "Statistics: On" : "Statistics: Off");
+}
+
 void SettingsState::addButtonLabel(Player::Action action, float y, const std::string& text, Context context)
 {
 	mBindingButtons[action] = std::make_shared<GUI::Button>(context);
@@ -1,4 +1,5 @@
 #include <Book/SpriteNode.hpp>
+#include <Book/RenderSnapshot.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 
 SpriteNode::SpriteNode(const sf::Texture& texture)
@@ -15,3 +16,8 @@ void SpriteNode::drawCurrent(sf::RenderTarget& target, sf::RenderStates states)
 {
 	target.draw(mSprite, states);
 }
+
+void SpriteNode::snapshotCurrent(RenderSnapshot& snapshot, sf::RenderStates states) const
+{
+	snapshot.addToScene(mSprite, states);
+}
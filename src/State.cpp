@@ -1,19 +1,26 @@
 #include <Book/State.hpp>
 #include <Book/StateStack.hpp>
 
-State::Context::Context(sf::RenderWindow& window, TextureHolder& textures, FontHolder& fonts, Player& player, MusicPlayer& music, SoundPlayer& sounds)
+State::Context::Context(sf::RenderWindow& window, TextureHolder& textures, FontHolder& fonts, Player& player, MusicPlayer& music, SoundPlayer& sounds, JobSystem& jobs, GraphicsSettings& graphics,
+	RenderTargetPool& renderTargets, CollisionStatistics& collisions, sf::Uint64 seed)
 : window(&window)
 , textures(&textures)
 , fonts(&fonts)
 , player(&player)
 , music(&music)
 , sounds(&sounds)
+, jobs(&jobs)
+, graphics(&graphics)
+, renderTargets(&renderTargets)
+, collisions(&collisions)
+, seed(seed)
 {
 }
 
 State::State(StateStack& stack, Context context)
 : mStack(&stack)
 , mContext(context)
+, mNeedsRedraw(true)
 {
 }
 
@@ -21,6 +28,32 @@ State::~State()
 {
 }
 
+bool State::freezesStatesBelow() const
+{
+	return false;
+}
+
+bool State::isOpaque() const
+{
+	return false;
+}
+
+bool State::isAnimated() const
+{
+	// 画面随插值连续变化的状态每帧都要重新绘制
+	return false;
+}
+
+bool State::needsRedraw() const
+{
+	return mNeedsRedraw;
+}
+
+void State::markDrawn()
+{
+	mNeedsRedraw = false;
+}
+
 void State::requestStackPush(States::ID stateID)
 {
 	mStack->pushState(stateID);
@@ -36,6 +69,11 @@ void State::requestStateClear()
 	mStack->clearStates();
 }
 
+void State::requestRedraw()
+{
+	mNeedsRedraw = true;
+}
+
 State::Context State::getContext() const
 {
 	return mContext;
@@ -1,5 +1,8 @@
 #include <Book/StateStack.hpp>
 #include <Book/Foreach.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <algorithm>
 #include <cassert>
 
 StateStack::StateStack(State::Context context)
@@ -7,6 +10,11 @@ StateStack::StateStack(State::Context context)
 , mPendingList()
 , mContext(context)
 , mFactories()
+, mChangeCallback()
+, mNeedsRedraw(true)
+, mFrozenTexture()
+, mFrozenSprite()
+, mFrozenFrameValid(false)
 {
 }
 
@@ -22,11 +30,37 @@ void StateStack::update(sf::Time dt)
 	applyPendingChanges();
 }
 
-void StateStack::draw()
+void StateStack::draw(float interpolation)
 {
-	// ջʾ״̬
-	FOREACH(State::Ptr& state, mStack)
-		state->draw();
+	// ͸״̬ȫס״̬Ҫ
+	std::size_t firstVisible = getFirstVisibleState();
+	// ״ֻ̬һΣֱ֮ʹûĻ
+	std::size_t frozenCount = getFrozenStateCount();
+	if (frozenCount > firstVisible)
+	{
+		if (mFrozenFrameValid)
+			drawFrozenFrame();
+		else
+			captureFrozenFrame(firstVisible, frozenCount, interpolation);
+	}
+	// ջʾ״̬
+	for (std::size_t i = std::max(firstVisible, frozenCount); i < mStack.size(); ++i)
+	{
+		mStack[i]->draw(interpolation);
+		mStack[i]->markDrawn();
+	}
+	mNeedsRedraw = false;
+}
+
+void StateStack::snapshot(RenderSnapshot& snapshot, float interpolation)
+{
+	// ·ʹöử棬״̬ÿ֡¼¼һΣݲ䣬ֻ໨¼ʱ䣩
+	for (std::size_t i = getFirstVisibleState(); i < mStack.size(); ++i)
+	{
+		mStack[i]->snapshot(snapshot, interpolation);
+		mStack[i]->markDrawn();
+	}
+	mNeedsRedraw = false;
 }
 
 void StateStack::handleEvent(const sf::Event& event)
@@ -60,6 +94,33 @@ bool StateStack::isEmpty() const
 	return mStack.empty();
 }
 
+bool StateStack::needsRedraw() const
+{
+	// ջ仯һ״̬Ļб仯ʱҪ»
+	if (mNeedsRedraw)
+		return true;
+	// ס״̬ʹб仯Ҳ״̬˶
+	std::size_t frozenCount = getFrozenStateCount();
+	for (std::size_t i = getFirstVisibleState(); i < mStack.size(); ++i)
+	{
+		if (mStack[i]->needsRedraw() || (i >= frozenCount && mStack[i]->isAnimated()))
+			return true;
+	}
+	return false;
+}
+
+void StateStack::requestRedraw()
+{
+	// ⲿҪػ棨細ڳߴ仯Ҳɶử
+	mNeedsRedraw = true;
+	mFrozenFrameValid = false;
+}
+
+void StateStack::setChangeCallback(std::function<void()> callback)
+{
+	mChangeCallback = std::move(callback);
+}
+
 State::Ptr StateStack::createState(States::ID stateID)
 {
 	auto found = mFactories.find(stateID);
@@ -69,6 +130,14 @@ State::Ptr StateStack::createState(States::ID stateID)
 
 void StateStack::applyPendingChanges()
 {
+	// ״̬лǰ֪ͨⲿȾ߳ͷŶԾԴ
+	if (!mPendingList.empty() && mChangeCallback)
+		mChangeCallback();
+	if (!mPendingList.empty())
+	{
+		mNeedsRedraw = true;
+		mFrozenFrameValid = false;
+	}
 	FOREACH(PendingChange change, mPendingList)
 	{
 		switch (change.action)
@@ -88,6 +157,52 @@ void StateStack::applyPendingChanges()
 	mPendingList.clear();
 }
 
+std::size_t StateStack::getFirstVisibleState() const
+{
+	// ջҵһ͸״̬
+	for (std::size_t i = mStack.size(); i > 0; --i)
+	{
+		if (mStack[i - 1]->isOpaque())
+			return i - 1;
+	}
+	return 0;
+}
+
+std::size_t StateStack::getFrozenStateCount() const
+{
+	// һҪ󶳽״̬֮µ״̬
+	for (std::size_t i = mStack.size(); i > 0; --i)
+	{
+		if (mStack[i - 1]->freezesStatesBelow())
+			return i - 1;
+	}
+	return 0;
+}
+
+void StateStack::captureFrozenFrame(std::size_t begin, std::size_t end, float interpolation)
+{
+	for (std::size_t i = begin; i < end; ++i)
+	{
+		mStack[i]->draw(interpolation);
+		mStack[i]->markDrawn();
+	}
+	// ڵǰݸƵ
+	sf::RenderWindow& window = *mContext.window;
+	sf::Vector2u size = window.getSize();
+	if (mFrozenTexture.getSize() != size && !mFrozenTexture.create(size.x, size.y))
+		return;
+	mFrozenTexture.update(window);
+	mFrozenSprite.setTexture(mFrozenTexture, true);
+	mFrozenFrameValid = true;
+}
+
+void StateStack::drawFrozenFrame()
+{
+	sf::RenderWindow& window = *mContext.window;
+	window.setView(window.getDefaultView());
+	window.draw(mFrozenSprite);
+}
+
 StateStack::PendingChange::PendingChange(Action action, States::ID stateID)
 : action(action)
 , stateID(stateID)
@@ -1,4 +1,5 @@
 #include <Book/TextNode.hpp>
+#include <Book/RenderSnapshot.hpp>
 #include <Book/Utility.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 
@@ -14,6 +15,11 @@ void TextNode::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) co
 	target.draw(mText, states);
 }
 
+void TextNode::snapshotCurrent(RenderSnapshot& snapshot, sf::RenderStates states) const
+{
+	snapshot.addToScene(mText, states);
+}
+
 void TextNode::setString(const std::string& text)
 {
 	mText.setString(text);
@@ -0,0 +1,110 @@
+#include <Book/TileMapNode.hpp>
+#include <Book/RenderSnapshot.hpp>
+#include <Book/Foreach.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+TileMapNode::TileMapNode(const sf::Texture& tileset, const std::string& filename, sf::FloatRect bounds,
+	float tileSize, std::size_t chunkRows)
+: mTileset(tileset)
+, mFile(filename.c_str())
+, mBounds(bounds)
+, mTileSize(tileSize)
+, mChunkRows(chunkRows)
+, mColumns(static_cast<std::size_t>(std::ceil(bounds.width / tileSize)))
+, mNextChunk(0)
+, mChunks()
+{
+}
+
+void TileMapNode::stream(sf::FloatRect viewBounds)
+{
+	// 视野上下各多保留一个块的距离作为预读区域
+	float chunkHeight = mTileSize * mChunkRows;
+	float top = std::max(viewBounds.top - chunkHeight, mBounds.top);
+	float bottom = viewBounds.top + viewBounds.height + chunkHeight;
+	// 关卡只会向上滚动，所以块按顺序从文件读入
+	while (getChunkBottom(mNextChunk) > top)
+		loadChunk(mNextChunk++);
+	// 释放已经落到镜头后方的块
+	while (!mChunks.empty() && getChunkBottom(mChunks.front().index) - chunkHeight > bottom)
+		mChunks.pop_front();
+}
+
+std::size_t TileMapNode::getLoadedChunkCount() const
+{
+	return mChunks.size();
+}
+
+void TileMapNode::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	states.texture = &mTileset;
+	FOREACH(const Chunk& chunk, mChunks)
+		target.draw(chunk.vertices, states);
+}
+
+void TileMapNode::snapshotCurrent(RenderSnapshot& snapshot, sf::RenderStates states) const
+{
+	states.texture = &mTileset;
+	FOREACH(const Chunk& chunk, mChunks)
+		snapshot.addToScene(chunk.vertices, states);
+}
+
+void TileMapNode::loadChunk(std::size_t index)
+{
+	Chunk chunk;
+	chunk.index = index;
+	chunk.vertices.setPrimitiveType(sf::Quads);
+	std::vector<unsigned int> tiles;
+	float chunkBottom = getChunkBottom(index);
+	for (std::size_t row = 0; row < mChunkRows; ++row)
+	{
+		float y = chunkBottom - (row + 1) * mTileSize;
+		if (y + mTileSize <= mBounds.top)
+			break;
+		readRow(tiles);
+		for (std::size_t column = 0; column < mColumns; ++column)
+			appendTile(chunk.vertices, mBounds.left + column * mTileSize, y, tiles[column]);
+	}
+	mChunks.push_back(std::move(chunk));
+}
+
+void TileMapNode::readRow(std::vector<unsigned int>& tiles)
+{
+	// 文件缺失或读完之后用基础纹理填充
+	tiles.assign(mColumns, 0);
+	std::string line;
+	while (mFile && std::getline(mFile, line))
+	{
+		if (line.empty() || line[0] == '#')
+			continue;
+		std::istringstream stream(line);
+		for (std::size_t column = 0; column < mColumns && stream >> tiles[column]; ++column)
+		{
+		}
+		return;
+	}
+}
+
+void TileMapNode::appendTile(sf::VertexArray& vertices, float x, float y, unsigned int tile) const
+{
+	sf::Vector2f texCoords(x - mBounds.left, y - mBounds.top);
+	if (tile > 0)
+	{
+		unsigned int columns = std::max(1u, static_cast<unsigned int>(mTileset.getSize().x / mTileSize));
+		texCoords.x = ((tile - 1) % columns) * mTileSize;
+		texCoords.y = ((tile - 1) / columns) * mTileSize;
+	}
+	vertices.append(sf::Vertex(sf::Vector2f(x, y), texCoords));
+	vertices.append(sf::Vertex(sf::Vector2f(x + mTileSize, y), texCoords + sf::Vector2f(mTileSize, 0.f)));
+	vertices.append(sf::Vertex(sf::Vector2f(x + mTileSize, y + mTileSize), texCoords + sf::Vector2f(mTileSize, mTileSize)));
+	vertices.append(sf::Vertex(sf::Vector2f(x, y + mTileSize), texCoords + sf::Vector2f(0.f, mTileSize)));
+}
+
+float TileMapNode::getChunkBottom(std::size_t index) const
+{
+	return mBounds.top + mBounds.height - index * mChunkRows * mTileSize;
+}
@@ -1,6 +1,7 @@
 #include <Book/TitleState.hpp>
 #include <Book/Utility.hpp>
 #include <Book/ResourceHolder.hpp>
+#include <Book/RenderSnapshot.hpp>
 
 #include <SFML/Graphics/RenderWindow.hpp>
 
@@ -19,15 +20,24 @@ TitleState::TitleState(StateStack& stack, Context context)
 	mText.setPosition(sf::Vector2f(context.window->getSize() / 2u));
 }
 
-void TitleState::draw()
+void TitleState::draw(float)
 {
 	sf::RenderWindow& window = *getContext().window;
+	window.setView(window.getDefaultView());
 	window.draw(mBackgroundSprite);
 
 	if (mShowText)
 		window.draw(mText);
 }
 
+void TitleState::snapshot(RenderSnapshot& snapshot, float)
+{
+	snapshot.addToOverlay(mBackgroundSprite);
+
+	if (mShowText)
+		snapshot.addToOverlay(mText);
+}
+
 bool TitleState::update(sf::Time dt)
 {
 	mTextEffectTime += dt;
@@ -36,11 +46,17 @@ bool TitleState::update(sf::Time dt)
 	{
 		mShowText = !mShowText;
 		mTextEffectTime = sf::Time::Zero;
+		requestRedraw();
 	}
 
 	return true;
 }
 
+bool TitleState::isOpaque() const
+{
+	return true;
+}
+
 bool TitleState::handleEvent(const sf::Event& event)
 {
 	// If any key is pressed, trigger the next screen
@@ -2,23 +2,11 @@
 #include <Book/Animation.hpp>
 #include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/Text.hpp>
-#include <random>
+#include <SFML/Graphics/Font.hpp>
+#include <algorithm>
 #include <cmath>
-#include <ctime>
 #include <cassert>
 
-
-namespace
-{
-	std::default_random_engine createRandomEngine()
-	{
-		auto seed = static_cast<unsigned long>(std::time(nullptr));
-		return std::default_random_engine(seed);
-	}
-
-	auto RandomEngine = createRandomEngine();
-}
-
 std::string toString(sf::Keyboard::Key key)
 {
 	#define BOOK_KEYTOSTRING_CASE(KEY) case sf::Keyboard::KEY: return #KEY;
@@ -142,6 +130,13 @@ void centerOrigin(sf::Text& text)
 	text.setOrigin(std::floor(bounds.width / 2.f), std::floor(bounds.height / 2.f));
 }
 
+void preloadGlyphs(const sf::Font& font, unsigned int characterSize)
+{
+	// 载入全部可打印 ASCII 字符，之后显示这些字符不会再修改字体纹理
+	for (sf::Uint32 character = ' '; character <= '~'; ++character)
+		font.getGlyph(character, characterSize, false);
+}
+
 void centerOrigin(Animation& animation)
 {
 	sf::FloatRect bounds = animation.getLocalBounds();
@@ -158,12 +153,6 @@ float toRadian(float degree)
 	return 3.141592653589793238462643383f / 180.f * degree;
 }
 
-int randomInt(int exclusiveMax)
-{
-	std::uniform_int_distribution<> distr(0, exclusiveMax - 1);
-	return distr(RandomEngine);
-}
-
 float length(sf::Vector2f vector)
 {
 	return std::sqrt(vector.x * vector.x + vector.y * vector.y);
@@ -174,3 +163,32 @@ sf::Vector2f unitVector(sf::Vector2f vector)
 	assert(vector != sf::Vector2f(0.f, 0.f));
 	return vector / length(vector);
 }
+
+bool sweptIntersects(const sf::FloatRect& moving, sf::Vector2f displacement, const sf::FloatRect& target)
+{
+	// moving 是移动结束时的矩形，这一步之前位于 moving - displacement
+	// 目标按移动矩形的尺寸扩大后，问题变为左上角的运动线段与扩大矩形求交（分轴求进入和离开的时间）
+	float start[2] = {moving.left - displacement.x, moving.top - displacement.y};
+	float delta[2] = {displacement.x, displacement.y};
+	float lower[2] = {target.left - moving.width, target.top - moving.height};
+	float upper[2] = {target.left + target.width, target.top + target.height};
+	float enter = 0.f;
+	float exit = 1.f;
+	for (int axis = 0; axis < 2; ++axis)
+	{
+		if (delta[axis] == 0.f)
+		{
+			// 这一轴上没有移动，必须一直处在重叠区间内
+			if (start[axis] <= lower[axis] || start[axis] >= upper[axis])
+				return false;
+			continue;
+		}
+		float t1 = (lower[axis] - start[axis]) / delta[axis];
+		float t2 = (upper[axis] - start[axis]) / delta[axis];
+		enter = std::max(enter, std::min(t1, t2));
+		exit = std::min(exit, std::max(t1, t2));
+		if (enter >= exit)
+			return false;
+	}
+	return true;
+}
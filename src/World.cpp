@@ -5,38 +5,73 @@
 #include <Book/TextNode.hpp>
 #include <Book/ParticleNode.hpp>
 #include <Book/SoundNode.hpp>
+#include <Book/TileMapNode.hpp>
+#include <Book/BulletSystem.hpp>
+#include <Book/JobSystem.hpp>
+#include <Book/RenderSnapshot.hpp>
+#include <Book/GraphicsSettings.hpp>
+#include <Book/RenderTargetPool.hpp>
+#include <Book/DataTables.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/System/Clock.hpp>
 #include <algorithm>
 #include <cmath>
 #include <limits>
 
-World::World(sf::RenderTarget& outputTarget, FontHolder& fonts, SoundPlayer& sounds)
+World::World(sf::RenderTarget& outputTarget, FontHolder& fonts, SoundPlayer& sounds, JobSystem& jobs, GraphicsSettings& graphics,
+	RenderTargetPool& renderTargets, sf::Uint64 seed)
 : mTarget(outputTarget)
-, mSceneTexture()
+, mRenderTargets(renderTargets)
 , mWorldView(outputTarget.getDefaultView())
+, mPreviousViewCenter()
 , mTextures()
+, mMaskAtlas()
 , mFonts(fonts)
 , mSounds(sounds)
+, mJobs(jobs)
+, mEntities()
+, mCollisions()
+, mContacts()
+, mCollisionStatistics()
 , mSceneGraph()
 , mSceneLayers()
-, mWorldBounds(0.f, 0.f, mWorldView.getSize().x, 5000.f)
+, mLevel("Media/Levels/Level.dat")
+, mWorldBounds(0.f, 0.f, mWorldView.getSize().x, std::max(mLevel.getLevelLength(), mWorldView.getSize().y))
 , mSpawnPosition(mWorldView.getSize().x / 2.f, mWorldBounds.height - mWorldView.getSize().y / 2.f)
 , mScrollSpeed(-50.f)
 , mPlayerAircraft(nullptr)
-, mEnemySpawnPoints()
+, mBackground(nullptr)
+, mBullets(nullptr)
 , mActiveEnemies()
+, mCollidingAircraft()
+, mCollisionRects()
+, mCollisionMasks()
+, mCollisionDamages()
+, mParticles()
+, mRandom(seed)
+, mBloomEffect(renderTargets)
+, mCpuBloomEffect(jobs)
+, mGraphics(graphics)
 {
-	mSceneTexture.create(mTarget.getSize().x, mTarget.getSize().y);
+	mScrollSpeed = mLevel.getScrollSpeed();
 	loadTextures();
+	buildCollisionMasks();
 	buildScene();
+	registerCollisionResponses();
 	// ׼
 	mWorldView.setCenter(mSpawnPosition);
+	mPreviousViewCenter = mSpawnPosition;
+	mBackground->stream(getViewBounds());
 }
 
 void World::update(sf::Time dt)
 {
+	// ¼һͼͽڵλãڻƲֵ
+	mPreviousViewCenter = mWorldView.getCenter();
+	mSceneGraph.savePreviousTransform();
 	// ͼٶ
 	mWorldView.move(0.f, mScrollSpeed * dt.asSeconds());
+	mBackground->stream(getViewBounds());
 	mPlayerAircraft->setVelocity(0.f, 0.f);
 	// ݻʵ壬
 	destroyEntitiesOutsideView();
@@ -48,31 +83,71 @@ void World::update(sf::Time dt)
 	// ײԼӦ
 	handleCollisions();
 	// Ƴбٵʵ壬µĵ
-	mSceneGraph.removeWrecks();
+	mEntities.removeWrecks();
 	spawnEnemies();
+	// иʵ˶˳ִлĸ
+	updateEntities(dt);
 	// ϴÿһжλǷ񳬳߽
 	mSceneGraph.update(dt, mCommandQueue);
 	adaptPlayerPosition();
 	updateSounds();
 }
 
-void World::draw()
+void World::draw(float interpolation)
 {
-	if (PostEffect::isSupported())
+	// ͼͽڵ㶼ʣʱֵ֮
+	sf::View view = mWorldView;
+	view.setCenter(mPreviousViewCenter + (mWorldView.getCenter() - mPreviousViewCenter) * interpolation);
+	// ֱ̬ʣȻСϣϳʱŴ󵽴ڳߴ
+	sf::Vector2u targetSize = mTarget.getSize();
+	float scale = mGraphics.getResolutionScale();
+	sf::Vector2u sceneSize(static_cast<unsigned int>(targetSize.x * scale), static_cast<unsigned int>(targetSize.y * scale));
+	bool scaled = (sceneSize != targetSize);
+	// رշҲʱֱӻƵĿϣ
+	BloomEffect::Quality quality = mGraphics.getBloomQuality();
+	bool cpuBloom = mGraphics.usesCpuBloom();
+	if ((cpuBloom || PostEffect::isSupported()) && (quality != BloomEffect::Off || scaled))
 	{
-		mSceneTexture.clear();
-		mSceneTexture.setView(mWorldView);
-		mSceneTexture.draw(mSceneGraph);
-		mSceneTexture.display();
-		mBloomEffect.apply(mSceneTexture, mTarget);
+		sf::RenderTexture& sceneTexture = mRenderTargets.acquire(sceneSize);
+		sceneTexture.setSmooth(scaled);
+		sceneTexture.clear();
+		sceneTexture.setView(view);
+		mSceneGraph.drawInterpolated(sceneTexture, sf::RenderStates::Default, interpolation);
+		sceneTexture.display();
+		if (cpuBloom)
+		{
+			mCpuBloomEffect.setQuality(quality);
+			mCpuBloomEffect.setUpdateInterval(mGraphics.getBloomUpdateInterval());
+			mCpuBloomEffect.setHistoryWeight(mGraphics.getBloomHistoryWeight());
+			mCpuBloomEffect.apply(sceneTexture, mTarget);
+			mGraphics.setBloomStatistics(mCpuBloomEffect.getStatistics());
+		}
+		else
+		{
+			mBloomEffect.setQuality(quality);
+			mBloomEffect.setUpdateInterval(mGraphics.getBloomUpdateInterval());
+			mBloomEffect.setHistoryWeight(mGraphics.getBloomHistoryWeight());
+			mBloomEffect.apply(sceneTexture, mTarget);
+			mGraphics.setBloomStatistics(mBloomEffect.getStatistics());
+		}
+		mRenderTargets.release(sceneTexture);
 	}
 	else
 	{
-		mTarget.setView(mWorldView);
-		mTarget.draw(mSceneGraph);
+		mTarget.setView(view);
+		mSceneGraph.drawInterpolated(mTarget, sf::RenderStates::Default, interpolation);
 	}
 }
 
+void World::snapshot(RenderSnapshot& snapshot, float interpolation) const
+{
+	//  draw ͬزֵͼͽڵ㣬źͷȾ̴߳
+	sf::View view = mWorldView;
+	view.setCenter(mPreviousViewCenter + (mWorldView.getCenter() - mPreviousViewCenter) * interpolation);
+	snapshot.setSceneView(view);
+	mSceneGraph.snapshot(snapshot, sf::RenderStates::Default, interpolation);
+}
+
 CommandQueue& World::getCommandQueue()
 {
 	return mCommandQueue;
@@ -88,6 +163,17 @@ bool World::hasPlayerReachedEnd() const
 	return !mWorldBounds.contains(mPlayerAircraft->getPosition());
 }
 
+const CollisionStatistics& World::getCollisionStatistics() const
+{
+	return mCollisionStatistics;
+}
+
+sf::Uint64 World::getSeed() const
+{
+	// ͬһ¹ World һֵĵл͵
+	return mRandom.getSeed();
+}
+
 void World::loadTextures()
 {
 	mTextures.load(Textures::Entities, "Media/Textures/Entities.png");
@@ -97,6 +183,27 @@ void World::loadTextures()
 	mTextures.load(Textures::FinishLine, "Media/Textures/FinishLine.png");
 }
 
+void World::buildCollisionMasks()
+{
+	// ռʵʾȫΣҷɻ֡㶯
+	std::vector<sf::IntRect> rects;
+	FOREACH(const AircraftData& data, initializeAircraftData())
+	{
+		int frames = data.hasRollAnimation ? 3 : 1;
+		for (int frame = 0; frame < frames; ++frame)
+		{
+			sf::IntRect rect = data.textureRect;
+			rect.left += frame * rect.width;
+			rects.push_back(rect);
+		}
+	}
+	FOREACH(const ProjectileData& data, initializeProjectileData())
+		rects.push_back(data.textureRect);
+	FOREACH(const PickupData& data, initializePickupData())
+		rects.push_back(data.textureRect);
+	mMaskAtlas.build(mTextures.get(Textures::Entities), rects);
+}
+
 void World::adaptPlayerPosition()
 {
 	// ҵλòᳬ߽
@@ -120,58 +227,75 @@ void World::adaptPlayerVelocity()
 	mPlayerAircraft->accelerate(0.f, mScrollSpeed);
 }
 
-bool matchesCategories(SceneNode::Pair& colliders, Category::Type type1, Category::Type type2)
+void World::registerCollisionResponses()
 {
-	unsigned int category1 = colliders.first->getCategory();
-	unsigned int category2 = colliders.second->getCategory();
-	if (type1 & category1 && type2 & category2)
+	// ײ˺Ϊлʣ˺
+	mCollisions.addResponse<Aircraft, Aircraft>(Category::PlayerAircraft, Category::EnemyAircraft, [] (Aircraft& player, Aircraft& enemy)
 	{
-		return true;
-	}
-	else if (type1 & category2 && type2 & category1)
+		player.damage(enemy.getHitpoints());
+		enemy.destroy();
+	});
+	// ƷЧӵϣٲƷ
+	mCollisions.addResponse<Aircraft, Pickup>(Category::PlayerAircraft, Category::Pickup, [this] (Aircraft& player, Pickup& pickup)
 	{
-		std::swap(colliders.first, colliders.second);
-		return true;
-	}
-	else
+		pickup.apply(player);
+		pickup.destroy();
+		player.playLocalSound(mCommandQueue, SoundEffect::CollectPickup);
+	});
+	// жԵײܵ˺ٵ
+	auto projectileHit = [] (Aircraft& aircraft, Projectile& projectile)
 	{
-		return false;
-	}
+		aircraft.damage(projectile.getDamage());
+		projectile.destroy();
+	};
+	mCollisions.addResponse<Aircraft, Projectile>(Category::EnemyAircraft, Category::AlliedProjectile, projectileHit);
+	mCollisions.addResponse<Aircraft, Projectile>(Category::PlayerAircraft, Category::EnemyProjectile, projectileHit);
 }
 
 void World::handleCollisions()
 {
-	std::set<SceneNode::Pair> collisionPairs;
-	mSceneGraph.checkSceneCollision(mSceneGraph, collisionPairs);
-	FOREACH(SceneNode::Pair pair, collisionPairs)
+	sf::Clock clock;
+	// ڽյײϼ⣬ײ֮ϲ
+	// Ӵ¼дÿõĻһ
+	mContacts.clear();
+	mEntities.updateColliders(mMaskAtlas);
+	mEntities.checkCollisions(mCollisions, mContacts, mCollisionStatistics);
+	mCollisionStatistics.contacts = mContacts.size();
+	// Ӧ
+	FOREACH(const EntityStore::Contact& contact, mContacts)
+		mCollisions.dispatch(*contact.first, contact.firstCategory, *contact.second, contact.secondCategory);
+	// ӵӪ
+	mCollisionStatistics.bulletTests = 0;
+	mCollisionStatistics.bulletMaskTests = 0;
+	mCollisionStatistics.bulletHits = 0;
+	collideBullets(Category::EnemyAircraft, Projectile::AlliedBullet);
+	collideBullets(Category::PlayerAircraft, Projectile::EnemyBullet);
+	mCollisionStatistics.time = clock.getElapsedTime();
+}
+
+void World::collideBullets(Category::Type targets, Projectile::Type bulletType)
+{
+	Command collector;
+	collector.category = targets;
+	collector.action = derivedAction<Aircraft>([this] (Aircraft& aircraft, sf::Time)
 	{
-		if (matchesCategories(pair, Category::PlayerAircraft, Category::EnemyAircraft))
+		if (!aircraft.isDestroyed())
 		{
-			auto& player = static_cast<Aircraft&>(*pair.first);
-			auto& enemy = static_cast<Aircraft&>(*pair.second);
-			// ײ˺Ϊлʣ˺
-			player.damage(enemy.getHitpoints());
-			enemy.destroy();
-		}
-		else if (matchesCategories(pair, Category::PlayerAircraft, Category::Pickup))
-		{
-			auto& player = static_cast<Aircraft&>(*pair.first);
-			auto& pickup = static_cast<Pickup&>(*pair.second);
-			// ƷЧӵϣٲƷ
-			pickup.apply(player);
-			pickup.destroy();
-			player.playLocalSound(mCommandQueue, SoundEffect::CollectPickup);
-		}
-		else if (matchesCategories(pair, Category::EnemyAircraft, Category::AlliedProjectile)
-			  || matchesCategories(pair, Category::PlayerAircraft, Category::EnemyProjectile))
-		{
-			auto& aircraft = static_cast<Aircraft&>(*pair.first);
-			auto& projectile = static_cast<Projectile&>(*pair.second);
-			// жӵײܵ˺ӵ
-			aircraft.damage(projectile.getDamage());
-			projectile.destroy();
+			mCollidingAircraft.push_back(&aircraft);
+			mCollisionRects.push_back(aircraft.getHitBounds());
+			mCollisionMasks.push_back(aircraft.getPlacedMask(mMaskAtlas));
 		}
+	});
+	mSceneGraph.onCommand(collector, sf::Time::Zero);
+	mBullets->collide(bulletType, mCollisionRects, mCollisionMasks, mCollisionDamages, mCollisionStatistics);
+	for (std::size_t i = 0; i < mCollidingAircraft.size(); ++i)
+	{
+		if (mCollisionDamages[i] > 0)
+			mCollidingAircraft[i]->damage(mCollisionDamages[i]);
 	}
+	mCollidingAircraft.clear();
+	mCollisionRects.clear();
+	mCollisionMasks.clear();
 }
 
 void World::updateSounds()
@@ -193,16 +317,17 @@ void World::buildScene()
 		mSceneGraph.attachChild(std::move(layer));
 	}
 
-	// ׼ƽ̱
+	// ׼ƽ̱ԼյϷһҰĸ߶
 	sf::Texture& jungleTexture = mTextures.get(Textures::Jungle);
 	jungleTexture.setRepeated(true);
 	float viewHeight = mWorldView.getSize().y;
-	sf::IntRect textureRect(mWorldBounds);
-	textureRect.height += static_cast<int>(viewHeight);
-	// ӱ
-	std::unique_ptr<SpriteNode> jungleSprite(new SpriteNode(jungleTexture, textureRect));
-	jungleSprite->setPosition(mWorldBounds.left, mWorldBounds.top - viewHeight);
-	mSceneLayers[Background]->attachChild(std::move(jungleSprite));
+	sf::FloatRect backgroundBounds(mWorldBounds);
+	backgroundBounds.top -= viewHeight;
+	backgroundBounds.height += viewHeight;
+	// ӱͼ鰴Ұλôӹؿļзֿ
+	std::unique_ptr<TileMapNode> background(new TileMapNode(jungleTexture, "Media/Levels/Background.txt", backgroundBounds));
+	mBackground = background.get();
+	mSceneLayers[Background]->attachChild(std::move(background));
 	// ӽ
 	sf::Texture& finishTexture = mTextures.get(Textures::FinishLine);
 	std::unique_ptr<SpriteNode> finishSprite(new SpriteNode(finishTexture));
@@ -210,76 +335,79 @@ void World::buildScene()
 	mSceneLayers[Background]->attachChild(std::move(finishSprite));
 	// ӽڵ
 	std::unique_ptr<ParticleNode> smokeNode(new ParticleNode(Particle::Smoke, mTextures));
+	mParticles.registerNode(*smokeNode);
 	mSceneLayers[LowerAir]->attachChild(std::move(smokeNode));
 	// ƽЧ
 	std::unique_ptr<ParticleNode> propellantNode(new ParticleNode(Particle::Propellant, mTextures));
+	mParticles.registerNode(*propellantNode);
 	mSceneLayers[LowerAir]->attachChild(std::move(propellantNode));
+	// ӵϵͳ
+	std::unique_ptr<BulletSystem> bullets(new BulletSystem(mTextures, mMaskAtlas));
+	mBullets = bullets.get();
+	mSceneLayers[LowerAir]->attachChild(std::move(bullets));
 	// Ч
 	std::unique_ptr<SoundNode> soundNode(new SoundNode(mSounds));
 	mSceneGraph.attachChild(std::move(soundNode));
 	// ҷɻ
-	std::unique_ptr<Aircraft> player(new Aircraft(Aircraft::Eagle, mTextures, mFonts));
+	std::unique_ptr<Aircraft> player(new Aircraft(Aircraft::Eagle, mTextures, mFonts, mEntities, mParticles, mRandom));
 	mPlayerAircraft = player.get();
 	mPlayerAircraft->setPosition(mSpawnPosition);
 	mSceneLayers[UpperAir]->attachChild(std::move(player));
-	// ӵл
-	addEnemies();
 }
 
-void World::addEnemies()
+void World::spawnEnemies()
 {
-	//  ӵлָλ
-	addEnemy(Aircraft::Raptor,    0.f,  500.f);
-	addEnemy(Aircraft::Raptor,    0.f, 1000.f);
-	addEnemy(Aircraft::Raptor, +100.f, 1150.f);
-	addEnemy(Aircraft::Raptor, -100.f, 1150.f);
-	addEnemy(Aircraft::Avenger,  70.f, 1500.f);
-	addEnemy(Aircraft::Avenger, -70.f, 1500.f);
-	addEnemy(Aircraft::Avenger, -70.f, 1710.f);
-	addEnemy(Aircraft::Avenger,  70.f, 1700.f);
-	addEnemy(Aircraft::Avenger,  30.f, 1850.f);
-	addEnemy(Aircraft::Raptor,  300.f, 2200.f);
-	addEnemy(Aircraft::Raptor, -300.f, 2200.f);
-	addEnemy(Aircraft::Raptor,    0.f, 2200.f);
-	addEnemy(Aircraft::Raptor,    0.f, 2500.f);
-	addEnemy(Aircraft::Avenger,-300.f, 2700.f);
-	addEnemy(Aircraft::Avenger,-300.f, 2700.f);
-	addEnemy(Aircraft::Raptor,    0.f, 3000.f);
-	addEnemy(Aircraft::Raptor,  250.f, 3250.f);
-	addEnemy(Aircraft::Raptor, -250.f, 3250.f);
-	addEnemy(Aircraft::Avenger,   0.f, 3500.f);
-	addEnemy(Aircraft::Avenger,   0.f, 3700.f);
-	addEnemy(Aircraft::Raptor,    0.f, 3800.f);
-	addEnemy(Aircraft::Avenger,   0.f, 4000.f);
-	addEnemy(Aircraft::Avenger,-200.f, 4200.f);
-	addEnemy(Aircraft::Raptor,  200.f, 4200.f);
-	addEnemy(Aircraft::Raptor,    0.f, 4400.f);
-	// Yел
-	std::sort(mEnemySpawnPoints.begin(), mEnemySpawnPoints.end(), [] (SpawnPoint lhs, SpawnPoint rhs)
+	// ؿ¼ֻѾսΧ¼
+	float battlefieldTop = getBattlefieldBounds().top;
+	while (mLevel.hasPendingEvent()
+		&& mSpawnPosition.y - mLevel.peekEvent().distance > battlefieldTop)
 	{
-		return lhs.y < rhs.y;
-	});
+		applyLevelEvent(mLevel.peekEvent());
+		mLevel.popEvent();
+	}
 }
 
-void World::addEnemy(Aircraft::Type type, float relX, float relY)
+void World::applyLevelEvent(const LevelEvent& event)
 {
-	SpawnPoint spawn(type, mSpawnPosition.x + relX, mSpawnPosition.y - relY);
-	mEnemySpawnPoints.push_back(spawn);
+	float x = mSpawnPosition.x + event.x;
+	float y = mSpawnPosition.y - event.distance;
+	switch (event.type)
+	{
+		case LevelEvent::SpawnEnemy:
+			if (event.subtype < Aircraft::TypeCount)
+				spawnEnemy(static_cast<Aircraft::Type>(event.subtype), x, y);
+			break;
+		case LevelEvent::SpawnWave:
+			// еĵл x Ϊˮƽſ
+			if (event.subtype < Aircraft::TypeCount)
+			{
+				for (std::size_t i = 0; i < event.count; ++i)
+				{
+					float offset = (i - (event.count - 1) / 2.f) * event.value;
+					spawnEnemy(static_cast<Aircraft::Type>(event.subtype), x + offset, y);
+				}
+			}
+			break;
+		case LevelEvent::SpawnPickup:
+			if (event.subtype < Pickup::TypeCount)
+			{
+				std::unique_ptr<Pickup> pickup(new Pickup(static_cast<Pickup::Type>(event.subtype), mTextures, mEntities));
+				pickup->setPosition(x, y);
+				mSceneLayers[UpperAir]->attachChild(std::move(pickup));
+			}
+			break;
+		case LevelEvent::ChangeScrollSpeed:
+			mScrollSpeed = event.value;
+			break;
+	}
 }
 
-void World::spawnEnemies()
+void World::spawnEnemy(Aircraft::Type type, float x, float y)
 {
-	// лͼ
-	while (!mEnemySpawnPoints.empty()
-		&& mEnemySpawnPoints.back().y > getBattlefieldBounds().top)
-	{
-		SpawnPoint spawn = mEnemySpawnPoints.back();
-		std::unique_ptr<Aircraft> enemy(new Aircraft(spawn.type, mTextures, mFonts));
-		enemy->setPosition(spawn.x, spawn.y);
-		enemy->setRotation(180.f);
-		mSceneLayers[UpperAir]->attachChild(std::move(enemy));
-		mEnemySpawnPoints.pop_back();
-	}
+	std::unique_ptr<Aircraft> enemy(new Aircraft(type, mTextures, mFonts, mEntities, mParticles, mRandom));
+	enemy->setPosition(x, y);
+	enemy->setRotation(180.f);
+	mSceneLayers[UpperAir]->attachChild(std::move(enemy));
 }
 
 void World::destroyEntitiesOutsideView()
@@ -335,6 +463,16 @@ void World::guideMissiles()
 	mActiveEnemies.clear();
 }
 
+void World::updateEntities(sf::Time dt)
+{
+	// ϵͳδʵ飺ȸٶȣͳһλƣÿʵֻ޸״̬
+	mEntities.steer(dt, mJobs);
+	mEntities.integrate(dt, mJobs);
+	mBullets->updateBullets(dt, getBattlefieldBounds(), mJobs);
+	for (std::size_t i = 0; i < Particle::ParticleCount; ++i)
+		mParticles.get(static_cast<Particle::Type>(i)).updateParticles(dt, mJobs);
+}
+
 sf::FloatRect World::getViewBounds() const
 {
 	return sf::FloatRect(mWorldView.getCenter() - mWorldView.getSize() / 2.f, mWorldView.getSize());